@@ -166,6 +166,8 @@ void battery_tile::update_internal( time_point, const tripoint_abs_ms &, distrib
     // TODO: Shouldn't have this function!
 }
 
+std::uint64_t battery_tile::change_count = 1;
+
 active_tile_data *battery_tile::clone() const
 {
     return new battery_tile( *this );
@@ -195,18 +197,23 @@ int battery_tile::get_resource() const
 
 int battery_tile::mod_resource( int amt )
 {
+    const int stored_before = stored;
+    int remainder = 0;
     // TODO: Avoid int64 math if possible
     std::int64_t sum = static_cast<std::int64_t>( stored ) + amt;
     if( sum >= max_stored ) {
         stored = max_stored;
-        return sum - max_stored;
+        remainder = sum - max_stored;
     } else if( sum <= 0 ) {
         stored = 0;
-        return sum - stored;
+        remainder = sum;
     } else {
         stored = sum;
-        return 0;
     }
+    if( stored != stored_before ) {
+        change_count++;
+    }
+    return remainder;
 }
 
 void charge_watcher_tile::update_internal( time_point /*to*/, const tripoint_abs_ms &p,
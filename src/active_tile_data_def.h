@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 #include "active_tile_data.h"
 #include "point.h"
 #include "type_id.h"
@@ -21,6 +23,12 @@ class battery_tile : public active_tile_data
         /* In kJ */
         int stored;
         int max_stored;
+        /**
+         * Counts changes to the charge of any battery, so that sums over batteries can
+         * tell whether they are still up to date. New batteries don't count, they only
+         * join a sum when its grid is rebuilt.
+         */
+        static std::uint64_t change_count;
 
         void update_internal( time_point to, const tripoint_abs_ms &p, distribution_grid &grid ) override;
         active_tile_data *clone() const override;
@@ -30,6 +30,8 @@
 #include "debug.h"
 #include "drop_token.h"
 #include "enums.h"
+#include "event.h"
+#include "event_bus.h"
 #include "field.h"
 #include "field_type.h"
 #include "fire.h"
@@ -340,6 +342,7 @@ void drop_on_map( Character &c, item_drop_reason reason,
     if( items.empty() ) {
         return;
     }
+    get_event_bus().send<event_type::character_drops_item>( c.getID(), items.front()->typeId() );
     map &here = get_map();
     const std::string ter_name = here.name( where );
     const bool can_move_there = here.passable( where );
@@ -17,6 +17,8 @@ bool fov_3d;
 bool static_z_effect = false;
 bool overmap_transparency = true;
 int fov_3d_z_range;
+bool parallel_map_cache = false;
+bool parallel_monster_sight = false;
 bool tile_iso;
 bool pixel_minimap_option = false;
 int PICKUP_RANGE;
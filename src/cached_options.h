@@ -59,6 +59,12 @@ extern bool fov_3d;
 /** 3D FoV range, in Z levels, in both directions. */
 extern int fov_3d_z_range;
 
+/** Rebuild independent per z-level map caches on worker threads. */
+extern bool parallel_map_cache;
+
+/** Compute what monsters see on worker threads before they plan. */
+extern bool parallel_monster_sight;
+
 /** Using isometric tileset. */
 extern bool tile_iso;
 
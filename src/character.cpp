@@ -824,6 +824,14 @@ int Character::sight_range( int light_level ) const
     return clamp( range, 1, sight_max );
 }
 
+int Character::max_sight_distance() const
+{
+    // Antennae and ground sonar sense creatures 5 tiles away, clairvoyance ignores light
+    return std::max( { Creature::max_sight_distance(), 5,
+                       std::min( clairvoyance(), MAX_CLAIRVOYANCE )
+                     } );
+}
+
 int Character::unimpaired_range() const
 {
     return std::min( sight_max, 60 );
@@ -1847,6 +1855,9 @@ void Character::calc_all_parts_hp( float hp_mod, float hp_adjustment, int str_ma
 // 'wears' vector is still allowed due to refactor exhaustion.
 void Character::recalc_sight_limits()
 {
+    const int old_sight_max = sight_max;
+    const float old_nv_range = nv_range;
+    const std::bitset<NUM_VISION_MODES> old_vision_modes = vision_mode_cache;
     sight_max = 9999;
     vision_mode_cache.reset();
 
@@ -1928,6 +1939,15 @@ void Character::recalc_sight_limits()
                has_effect_with_flag( flag_EFFECT_CLAIRVOYANCE ) ) {
         vision_mode_cache.set( VISION_CLAIRVOYANCE );
     }
+
+    // Everything that changes these goes through here, including invisibility from worn,
+    // activated and carried items, see @ref Creature::sight_cache_stats
+    const bool invisible = is_invisible();
+    if( sight_max != old_sight_max || nv_range != old_nv_range ||
+        vision_mode_cache != old_vision_modes || invisible != was_invisible ) {
+        was_invisible = invisible;
+        on_sight_change();
+    }
 }
 
 namespace vision
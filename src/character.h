@@ -415,6 +415,7 @@ class Character : public Creature, public location_visitable<Character>
         const tripoint &pos() const override;
         /** Returns the player's sight range */
         int sight_range( int light_level ) const override;
+        int max_sight_distance() const override;
         /** Returns the player maximum vision range factoring in mutations, diseases, and other effects */
         int  unimpaired_range() const;
         /** Returns true if overmap tile is within player line-of-sight */
@@ -2278,6 +2279,8 @@ class Character : public Creature, public location_visitable<Character>
         // "Raw" night vision range - just stats+mutations+items
         float nv_range = 0;
         int sight_max = 0;
+        // Result of is_invisible() when the vision values above were last calculated
+        bool was_invisible = false;
 
         // turn the character expired, if calendar::before_time_starts it has not been set yet.
         // TODO: change into an optional<time_point>
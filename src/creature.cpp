@@ -4,15 +4,21 @@
 #include <array>
 #include <cmath>
 #include <cstdlib>
+#include <future>
 #include <map>
 #include <memory>
 #include <optional>
+#include <thread>
+#include <unordered_map>
+#include <utility>
 
 #include "anatomy.h"
 #include "avatar.h"
 #include "calendar.h"
+#include "cata_utility.h"
 #include "character.h"
 #include "color.h"
+#include "coordinate_conversions.h"
 #include "cursesdef.h"
 #include "damage.h"
 #include "debug.h"
@@ -23,6 +29,7 @@
 #include "field.h"
 #include "game.h"
 #include "game_constants.h"
+#include "hash_utils.h"
 #include "int_id.h"
 #include "item.h"
 #include "json.h"
@@ -169,7 +176,10 @@ Creature::Creature( const Creature &source )
     }
 }
 
-Creature::~Creature() = default;
+Creature::~Creature()
+{
+    on_sight_change();
+}
 
 std::vector<std::string> Creature::get_grammatical_genders() const
 {
@@ -263,6 +273,174 @@ bool Creature::is_dangerous_field( const field_entry &entry ) const
     return entry.is_dangerous() && !is_immune_field( entry.get_field_type() );
 }
 
+namespace
+{
+
+struct sight_cache_entry {
+    tripoint observer_pos;
+    tripoint target_pos;
+    // See `sight_stamp`
+    int64_t stamp;
+    bool result;
+};
+
+struct sight_cache_data {
+    time_point turn = calendar::before_time_starts;
+    std::unordered_map<std::pair<const Creature *, const Creature *>, sight_cache_entry, cata::tuple_hash>
+    entries;
+    // Bumped whenever something that can block sight changes in a submap of the reality bubble
+    std::array<int64_t, MAPSIZE *MAPSIZE *OVERMAP_LAYERS> generations = {};
+    Creature::sight_cache_stats stats;
+};
+
+sight_cache_data &sight_cache()
+{
+    static sight_cache_data cache;
+    return cache;
+}
+
+int sight_generation_index( const tripoint &sm )
+{
+    return ( sm.z + OVERMAP_DEPTH ) * MAPSIZE * MAPSIZE + sm.y * MAPSIZE + sm.x;
+}
+
+// Sum of the generations of the submaps a line of sight between `a` and `b` can cross.
+// Generations only grow, so the sum changes whenever any of them does.
+int64_t sight_stamp( const sight_cache_data &cache, const tripoint &a, const tripoint &b )
+{
+    const tripoint lo = ms_to_sm_copy( tripoint( std::min( a.x, b.x ), std::min( a.y, b.y ),
+                                       std::min( a.z, b.z ) ) );
+    const tripoint hi = ms_to_sm_copy( tripoint( std::max( a.x, b.x ), std::max( a.y, b.y ),
+                                       std::max( a.z, b.z ) ) );
+    int64_t stamp = 0;
+    for( int z = std::max( lo.z, -OVERMAP_DEPTH ); z <= std::min( hi.z, OVERMAP_HEIGHT ); z++ ) {
+        for( int y = std::max( lo.y, 0 ); y <= std::min( hi.y, MAPSIZE - 1 ); y++ ) {
+            for( int x = std::max( lo.x, 0 ); x <= std::min( hi.x, MAPSIZE - 1 ); x++ ) {
+                stamp += cache.generations[sight_generation_index( tripoint( x, y, z ) )];
+            }
+        }
+    }
+    return stamp;
+}
+
+} // namespace
+
+void Creature::invalidate_sight_cache()
+{
+    sight_cache_data &cache = sight_cache();
+    if( cache.entries.empty() ) {
+        return;
+    }
+    cache.entries.clear();
+    cache.stats.invalidations++;
+    TracyPlot( "Sight cache hits", cache.stats.hits );
+    TracyPlot( "Sight cache misses", cache.stats.misses );
+}
+
+void Creature::invalidate_sight_cache( const tripoint &p )
+{
+    const tripoint sm = ms_to_sm_copy( p );
+    if( sm.x < 0 || sm.y < 0 || sm.x >= MAPSIZE || sm.y >= MAPSIZE ||
+        sm.z < -OVERMAP_DEPTH || sm.z > OVERMAP_HEIGHT ) {
+        return;
+    }
+    sight_cache_data &cache = sight_cache();
+    cache.generations[sight_generation_index( sm )]++;
+    cache.stats.invalidations++;
+}
+
+void Creature::invalidate_sight_cache( const int z )
+{
+    if( z < -OVERMAP_DEPTH || z > OVERMAP_HEIGHT ) {
+        return;
+    }
+    sight_cache_data &cache = sight_cache();
+    for( int y = 0; y < MAPSIZE; y++ ) {
+        for( int x = 0; x < MAPSIZE; x++ ) {
+            cache.generations[sight_generation_index( tripoint( x, y, z ) )]++;
+        }
+    }
+    cache.stats.invalidations++;
+}
+
+void Creature::precompute_sight( const std::vector<std::pair<const Creature *, const Creature *>>
+                                 &pairs )
+{
+    ZoneScoped;
+    // Only the pairs that `sees` would look up in the cache
+    std::vector<std::pair<const Creature *, const Creature *>> todo;
+    for( const auto &pair : pairs ) {
+        const Creature &observer = *pair.first;
+        const Creature &target = *pair.second;
+        if( &observer != &target && !target.is_hallucination() &&
+            ( fov_3d || debug_mode || observer.posz() == target.posz() ) ) {
+            todo.push_back( pair );
+        }
+    }
+    if( todo.empty() ) {
+        return;
+    }
+    // Filled lazily by `sees`, must be done before the workers start
+    for( int z = 0; z <= OVERMAP_HEIGHT; z++ ) {
+        g->natural_light_level( z );
+    }
+
+    // Not worth a thread for fewer pairs
+    constexpr size_t min_pairs_per_worker = 16;
+    const size_t num_workers = clamp<size_t>( todo.size() / min_pairs_per_worker, 1,
+                               std::max( 1u, std::thread::hardware_concurrency() ) );
+    std::vector<char> results( todo.size() );
+    const auto check_pairs = [&]( const size_t first ) {
+        map::skip_vision_cache = true;
+        for( size_t i = first; i < todo.size(); i += num_workers ) {
+            results[i] = todo[i].first->sees_uncached( *todo[i].second );
+        }
+        map::skip_vision_cache = false;
+    };
+    std::vector<std::future<void>> tasks;
+    tasks.reserve( num_workers - 1 );
+    for( size_t i = 1; i < num_workers; i++ ) {
+        tasks.push_back( std::async( std::launch::async, check_pairs, i ) );
+    }
+    check_pairs( 0 );
+    for( auto &task : tasks ) {
+        task.get();
+    }
+
+    sight_cache_data &cache = sight_cache();
+    if( cache.turn != calendar::turn ) {
+        invalidate_sight_cache();
+        cache.turn = calendar::turn;
+    }
+    for( size_t i = 0; i < todo.size(); i++ ) {
+        const Creature &observer = *todo[i].first;
+        const Creature &target = *todo[i].second;
+        cache.entries[ { &observer, &target } ] = sight_cache_entry{
+            observer.pos(), target.pos(), sight_stamp( cache, observer.pos(), target.pos() ), results[i] != 0
+        };
+        observer.in_sight_cache = true;
+        target.in_sight_cache = true;
+    }
+}
+
+const Creature::sight_cache_stats &Creature::get_sight_cache_stats()
+{
+    return sight_cache().stats;
+}
+
+void Creature::reset_sight_cache_stats()
+{
+    sight_cache().stats = sight_cache_stats();
+}
+
+void Creature::on_sight_change() const
+{
+    if( in_sight_cache ) {
+        in_sight_cache = false;
+        invalidate_sight_cache();
+    }
+}
+
 bool Creature::sees( const Creature &critter ) const
 {
     ZoneScoped;
@@ -283,6 +461,31 @@ bool Creature::sees( const Creature &critter ) const
         return false;
     }
 
+    sight_cache_data &cache = sight_cache();
+    if( cache.turn != calendar::turn ) {
+        invalidate_sight_cache();
+        cache.turn = calendar::turn;
+    }
+    const std::pair<const Creature *, const Creature *> key( this, &critter );
+    const int64_t stamp = sight_stamp( cache, pos(), critter.pos() );
+    const auto iter = cache.entries.find( key );
+    if( iter != cache.entries.end() && iter->second.observer_pos == pos() &&
+        iter->second.target_pos == critter.pos() && iter->second.stamp == stamp ) {
+        cache.stats.hits++;
+        ZoneValue( 1 );
+        return iter->second.result;
+    }
+    cache.stats.misses++;
+    ZoneValue( 0 );
+    const bool result = sees_uncached( critter );
+    cache.entries[key] = sight_cache_entry{ pos(), critter.pos(), stamp, result };
+    in_sight_cache = true;
+    critter.in_sight_cache = true;
+    return result;
+}
+
+bool Creature::sees_uncached( const Creature &critter ) const
+{
     // This check is ridiculously expensive so defer it to after everything else.
     auto visible = []( const Character * ch ) {
         return ch == nullptr || !ch->is_invisible();
@@ -383,6 +586,13 @@ bool Creature::sees( const tripoint &t, bool is_avatar, int range_mod ) const
     }
 }
 
+int Creature::max_sight_distance() const
+{
+    // Same bounds as `sees`: adjacent creatures are always seen and no light lets us see
+    // further than the longer of our day and night sight ranges.
+    return std::max( { 1, sight_range( default_daylight_level() ), sight_range( 0 ) } );
+}
+
 // Helper function to check if potential area of effect of a weapon overlaps vehicle
 // Maybe TODO: If this is too slow, precalculate a bounding box and clip the tested area to it
 static bool overlaps_vehicle( const std::set<tripoint> &veh_area, const tripoint &pos,
@@ -1196,6 +1406,7 @@ void Creature::add_effect( const efftype_id &eff_id, const time_duration &dur,
             e.set_intensity( e.get_max_intensity() );
         }
         ( *effects )[eff_id][bp] = e;
+        on_sight_change();
         if( Character *ch = as_character() ) {
             g->events().send<event_type::character_gains_effect>( ch->getID(), eff_id );
             if( is_player() && !type.get_apply_message().empty() ) {
@@ -1277,6 +1488,7 @@ bool Creature::remove_effect( const efftype_id &eff_id, const bodypart_str_id &b
         on_effect_int_change( e.get_id(), 0, e.get_bp() );
         e.set_removed();
     }
+    on_sight_change();
     // Sleep is a special case, since it affects max sight range and other effects
     // Must be below the set_removed above or we'll get an infinite loop
     if( ch != nullptr && eff_id == effect_sleep ) {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <climits>
+#include <cstdint>
 #include <map>
 #include <set>
 #include <unordered_map>
@@ -301,11 +302,42 @@ class Creature
         virtual bool sees( const tripoint &t, bool is_avatar = false, int range_mod = 0 ) const;
         /*@}*/
 
+        /**
+         * Results of @ref sees( const Creature & ) are cached for the current turn, per pair of
+         * creatures and as long as neither of them moves. Anything else that changes what can be
+         * seen (terrain, lighting, effects, movement mode) must invalidate the cache.
+         * Changes to the map only invalidate the pairs whose line of sight may cross the changed
+         * submap or z-level.
+         */
+        struct sight_cache_stats {
+            int64_t hits = 0;
+            int64_t misses = 0;
+            int64_t invalidations = 0;
+        };
+        static void invalidate_sight_cache();
+        /** Something that blocks sight changed at `p`, in local map coordinates. */
+        static void invalidate_sight_cache( const tripoint &p );
+        /** Something that blocks sight changed anywhere on z-level `z`. */
+        static void invalidate_sight_cache( int z );
+        /**
+         * Fill the sight cache with the answers of `observer.sees( target )` for the given pairs,
+         * computed on worker threads. Must not be called while anything else uses the map.
+         */
+        static void precompute_sight( const std::vector<std::pair<const Creature *, const Creature *>>
+                                      &pairs );
+        static const sight_cache_stats &get_sight_cache_stats();
+        static void reset_sight_cache_stats();
+
         /**
          * How far the creature sees under the given light. Places outside this range can
          * @param light_level See @ref game::light_level.
          */
         virtual int sight_range( int light_level ) const = 0;
+        /**
+         * Distance beyond which @ref sees( const Creature & ) fails whatever the lighting.
+         * Bounds the area searched for potential targets.
+         */
+        virtual int max_sight_distance() const;
 
         /** Returns an approximation of the creature's strength. */
         virtual float power_rating() const = 0;
@@ -978,6 +1010,8 @@ class Creature
         Creature &operator=( Creature && ) = default;
 
     protected:
+        /** Something that decides what we see or how visible we are changed, see @ref sight_cache_stats */
+        void on_sight_change() const;
         virtual void on_stat_change( const std::string &, int ) {}
         virtual void on_effect_int_change( const efftype_id &, int, const bodypart_str_id & ) {}
         virtual void on_damage_of_type( int, damage_type, const bodypart_id & ) {}
@@ -1030,6 +1064,10 @@ class Creature
     private:
         int pain = 0;
         bool underwater = false;
+        // Whether this creature appears in the sight cache, so it must be invalidated when we change
+        mutable bool in_sight_cache = false;
+
+        bool sees_uncached( const Creature &critter ) const;
 };
 
 
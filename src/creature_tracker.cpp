@@ -7,6 +7,7 @@
 #include <utility>
 
 #include "debug.h"
+#include "line.h"
 #include "mongroup.h"
 #include "monster.h"
 #include "mtype.h"
@@ -86,7 +87,7 @@ bool Creature_tracker::add( const shared_ptr_fast<monster> &critter_ptr )
     }
 
     monsters_list.emplace_back( critter_ptr );
-    monsters_by_location[critter.pos()] = critter_ptr;
+    set_location( critter.pos(), critter_ptr );
     add_to_faction_map( critter_ptr );
     return true;
 }
@@ -164,8 +165,11 @@ bool Creature_tracker::update_pos( const monster &critter, const tripoint &new_p
         return ptr.get() == &critter;
     } );
     if( iter != monsters_list.end() ) {
-        monsters_by_location.erase( critter.pos() );
-        monsters_by_location[new_pos] = *iter;
+        const auto old_iter = monsters_by_location.find( critter.pos() );
+        if( old_iter != monsters_by_location.end() ) {
+            erase_location( old_iter );
+        }
+        set_location( new_pos, *iter );
         return true;
     } else {
         const tripoint &old_pos = critter.pos();
@@ -184,7 +188,7 @@ void Creature_tracker::remove_from_location_map( const monster &critter )
 {
     const auto pos_iter = monsters_by_location.find( critter.pos() );
     if( pos_iter != monsters_by_location.end() && pos_iter->second.get() == &critter ) {
-        monsters_by_location.erase( pos_iter );
+        erase_location( pos_iter );
         return;
     }
 
@@ -195,10 +199,86 @@ void Creature_tracker::remove_from_location_map( const monster &critter )
         return v.second.get() == &critter;
     } );
     if( iter != monsters_by_location.end() ) {
-        monsters_by_location.erase( iter );
+        erase_location( iter );
+    }
+}
+
+void Creature_tracker::set_location( const tripoint &pos,
+                                     const shared_ptr_fast<monster> &critter )
+{
+    shared_ptr_fast<monster> &entry = monsters_by_location[pos];
+    if( entry ) {
+        // Replacing a dead monster or a hallucination
+        remove_from_bucket( pos, entry.get() );
+    }
+    entry = critter;
+    add_to_bucket( pos, critter.get() );
+}
+
+void Creature_tracker::erase_location(
+    std::unordered_map<tripoint, shared_ptr_fast<monster>>::iterator iter )
+{
+    remove_from_bucket( iter->first, iter->second.get() );
+    monsters_by_location.erase( iter );
+}
+
+void Creature_tracker::clear_locations()
+{
+    monsters_by_location.clear();
+    monsters_by_bucket.clear();
+    monsters_per_z.clear();
+}
+
+void Creature_tracker::add_to_bucket( const tripoint &pos, monster *critter )
+{
+    monsters_by_bucket[bucket_of( pos )].push_back( critter );
+    monsters_per_z[pos.z]++;
+}
+
+void Creature_tracker::remove_from_bucket( const tripoint &pos, const monster *critter )
+{
+    const auto bucket_iter = monsters_by_bucket.find( bucket_of( pos ) );
+    if( bucket_iter == monsters_by_bucket.end() ) {
+        return;
+    }
+    std::vector<monster *> &bucket = bucket_iter->second;
+    const auto iter = std::find( bucket.begin(), bucket.end(), critter );
+    if( iter == bucket.end() ) {
+        return;
+    }
+    // Keep the order stable, it decides the order of find_in_radius results.
+    bucket.erase( iter );
+    const auto z_iter = monsters_per_z.find( pos.z );
+    if( --z_iter->second == 0 ) {
+        monsters_per_z.erase( z_iter );
     }
 }
 
+std::vector<monster *> Creature_tracker::find_in_radius( const tripoint &center,
+        const int radius ) const
+{
+    std::vector<monster *> result;
+    const point lo = bucket_of( center - point( radius, radius ) ).xy();
+    const point hi = bucket_of( center + point( radius, radius ) ).xy();
+    for( auto z_iter = monsters_per_z.lower_bound( center.z - radius );
+         z_iter != monsters_per_z.end() && z_iter->first <= center.z + radius; ++z_iter ) {
+        for( int y = lo.y; y <= hi.y; y++ ) {
+            for( int x = lo.x; x <= hi.x; x++ ) {
+                const auto iter = monsters_by_bucket.find( tripoint( x, y, z_iter->first ) );
+                if( iter == monsters_by_bucket.end() ) {
+                    continue;
+                }
+                for( monster *critter : iter->second ) {
+                    if( !critter->is_dead() && rl_dist( center, critter->pos() ) <= radius ) {
+                        result.push_back( critter );
+                    }
+                }
+            }
+        }
+    }
+    return result;
+}
+
 void Creature_tracker::remove( const monster &critter )
 {
     const auto iter = std::find_if( monsters_list.begin(), monsters_list.end(),
@@ -227,17 +307,17 @@ void Creature_tracker::remove( const monster &critter )
 void Creature_tracker::clear()
 {
     monsters_list.clear();
-    monsters_by_location.clear();
+    clear_locations();
     monster_faction_map_.clear();
     removed_.clear();
 }
 
 void Creature_tracker::rebuild_cache()
 {
-    monsters_by_location.clear();
+    clear_locations();
     monster_faction_map_.clear();
     for( const shared_ptr_fast<monster> &mon_ptr : monsters_list ) {
-        monsters_by_location[mon_ptr->pos()] = mon_ptr;
+        set_location( mon_ptr->pos(), mon_ptr );
         add_to_faction_map( mon_ptr );
     }
 }
@@ -256,13 +336,13 @@ void Creature_tracker::swap_positions( monster &first, monster &second )
     shared_ptr_fast<monster> first_ptr;
     if( first_iter != monsters_by_location.end() ) {
         first_ptr = first_iter->second;
-        monsters_by_location.erase( first_iter );
+        erase_location( first_iter );
     }
 
     shared_ptr_fast<monster> second_ptr;
     if( second_iter != monsters_by_location.end() ) {
         second_ptr = second_iter->second;
-        monsters_by_location.erase( second_iter );
+        erase_location( second_iter );
     }
     // implied: (first_ptr != second_ptr) or (first_ptr == nullptr && second_ptr == nullptr)
 
@@ -272,10 +352,10 @@ void Creature_tracker::swap_positions( monster &first, monster &second )
 
     // If the pointers have been taken out of the list, put them back in.
     if( first_ptr ) {
-        monsters_by_location[first.pos()] = first_ptr;
+        set_location( first.pos(), first_ptr );
     }
     if( second_ptr ) {
-        monsters_by_location[second.pos()] = second_ptr;
+        set_location( second.pos(), second_ptr );
     }
 }
 
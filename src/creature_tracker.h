@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstddef>
+#include <map>
 #include <memory>
 #include <set>
 #include <unordered_map>
@@ -80,6 +81,14 @@ class Creature_tracker
         /** Removes dead monsters from. Their pointers are invalidated. */
         void remove_dead();
 
+        /**
+         * Returns the living monsters within @p radius (as per @ref rl_dist) of @p center.
+         * Only the buckets of @ref monsters_by_bucket that overlap the radius are looked at,
+         * so this is much cheaper than filtering the whole monster list for small radii.
+         * The order is deterministic but unrelated to the order of @ref get_monsters_list.
+         */
+        std::vector<monster *> find_in_radius( const tripoint &center, int radius ) const;
+
         const std::vector<shared_ptr_fast<monster>> &get_monsters_list() const {
             return monsters_list;
         }
@@ -94,6 +103,24 @@ class Creature_tracker
     private:
         std::vector<shared_ptr_fast<monster>> monsters_list;
         std::unordered_map<tripoint, shared_ptr_fast<monster>> monsters_by_location;
+        /**
+         * Monsters of @ref monsters_by_location grouped in squares of bucket_size x bucket_size
+         * tiles on one z-level, keyed by the position of the square.
+         */
+        std::unordered_map<tripoint, std::vector<monster *>> monsters_by_bucket;
+        /** Number of monsters in @ref monsters_by_bucket per z-level, levels without any are absent */
+        std::map<int, int> monsters_per_z;
+        static constexpr int bucket_bits = 4;
+        static constexpr int bucket_size = 1 << bucket_bits;
+        static tripoint bucket_of( const tripoint &pos ) {
+            return tripoint( pos.x >> bucket_bits, pos.y >> bucket_bits, pos.z );
+        }
+        /** Set or erase the entry in @ref monsters_by_location, keeping @ref monsters_by_bucket in sync */
+        void set_location( const tripoint &pos, const shared_ptr_fast<monster> &critter );
+        void erase_location( std::unordered_map<tripoint, shared_ptr_fast<monster>>::iterator iter );
+        void clear_locations();
+        void add_to_bucket( const tripoint &pos, monster *critter );
+        void remove_from_bucket( const tripoint &pos, const monster *critter );
         /** Remove the monsters entry in @ref monsters_by_location */
         void remove_from_location_map( const monster &critter );
 };
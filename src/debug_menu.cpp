@@ -541,6 +541,8 @@ void character_edit_menu( Character &c )
         } else {
             data << _( "No destination." ) << '\n';
         }
+        data << string_format( _( "AI time: %d us last turn, %d us on average" ),
+                               np->ai_time_last_turn().count(), np->ai_time_average().count() ) << '\n';
         data << string_format( _( "Trust: %d" ), np->op_of_u.trust ) << " "
              << string_format( _( "Fear: %d" ), np->op_of_u.fear ) << " "
              << string_format( _( "Value: %d" ), np->op_of_u.value ) << " "
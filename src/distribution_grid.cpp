@@ -1,4 +1,5 @@
 #include <unordered_set>
+#include <utility>
 
 #include "character.h"
 #include "debug.h"
@@ -16,26 +17,97 @@
 
 static distribution_grid empty_grid( {}, MAPBUFFER );
 
+std::uint64_t grid_battery_changes::foreign() const
+{
+    return battery_tile::change_count - own;
+}
+
+std::uint64_t distribution_grid::battery_recounts = 0;
+
 distribution_grid::distribution_grid( const std::vector<tripoint_abs_sm> &global_submap_coords,
-                                      mapbuffer &buffer ) :
+                                      mapbuffer &buffer, shared_ptr_fast<grid_battery_changes> changes ) :
     submap_coords( global_submap_coords ),
+    battery_changes( std::move( changes ) ),
     mb( buffer )
 {
     for( const tripoint_abs_sm &sm_coord : submap_coords ) {
         submap *sm = mb.lookup_submap( sm_coord );
         if( sm == nullptr ) {
             // Debugmsg already printed in mapbuffer.cpp
-            return;
+            break;
         }
 
-        for( auto &active : sm->active_furniture ) {
-            const tripoint_abs_ms abs_pos = project_combine( sm_coord, active.first );
-            contents[sm_coord].emplace_back( active.first, abs_pos );
-            flat_contents.emplace_back( abs_pos );
+        add_submap_contents( sm_coord, *sm );
+    }
+}
+
+template<typename T>
+static T *active_tile_at( submap &sm, const point_sm_ms &p )
+{
+    auto iter = sm.active_furniture.find( p );
+    if( iter == sm.active_furniture.end() ) {
+        return nullptr;
+    }
+    return dynamic_cast<T *>( &*iter->second );
+}
+
+void distribution_grid::add_submap_contents( const tripoint_abs_sm &sm_coord, submap &sm )
+{
+    for( auto &active : sm.active_furniture ) {
+        const tripoint_abs_ms abs_pos = project_combine( sm_coord, active.first );
+        contents[sm_coord].emplace_back( active.first, abs_pos );
+        flat_contents.emplace_back( abs_pos );
+        if( dynamic_cast<battery_tile *>( &*active.second ) != nullptr ) {
+            batteries[sm_coord].emplace_back( active.first, abs_pos );
+        } else if( dynamic_cast<vehicle_connector_tile *>( &*active.second ) != nullptr ) {
+            connectors.emplace_back( abs_pos );
         }
     }
 }
 
+const grid_battery_totals &distribution_grid::get_battery_totals() const
+{
+    if( battery_totals_valid && battery_totals_at == battery_changes->foreign() ) {
+        return battery_totals;
+    }
+    battery_recounts++;
+    battery_totals = grid_battery_totals();
+    for( const auto &c : batteries ) {
+        submap *sm = mb.lookup_submap( c.first );
+        if( sm == nullptr ) {
+            continue;
+        }
+        for( const tile_location &loc : c.second ) {
+            const battery_tile *battery = active_tile_at<battery_tile>( *sm, loc.on_submap );
+            if( battery == nullptr ) {
+                continue;
+            }
+            battery_totals.stored += battery->stored;
+            battery_totals.capacity += battery->max_stored;
+        }
+    }
+    battery_totals_at = battery_changes->foreign();
+    battery_totals_valid = true;
+    return battery_totals;
+}
+
+void distribution_grid::on_submap_changed( const tripoint_abs_sm &sm_coord )
+{
+    const auto on_submap = [&sm_coord]( const tripoint_abs_ms & p ) {
+        return project_to<coords::sm>( p ) == sm_coord;
+    };
+    contents.erase( sm_coord );
+    batteries.erase( sm_coord );
+    std::erase_if( flat_contents, on_submap );
+    std::erase_if( connectors, on_submap );
+
+    submap *sm = mb.lookup_submap( sm_coord );
+    if( sm != nullptr ) {
+        add_submap_contents( sm_coord, *sm );
+    }
+    battery_totals_valid = false;
+}
+
 bool distribution_grid::empty() const
 {
     return contents.empty();
@@ -70,49 +142,77 @@ void distribution_grid::update( time_point to )
 #include "vehicle.h"
 #include "vehicle_part.h"
 static itype_id itype_battery( "battery" );
-int distribution_grid::mod_resource( int amt, bool recurse )
+
+vehicle *distribution_grid::first_connected_vehicle() const
 {
-    std::vector<vehicle *> connected_vehicles;
-    for( const auto &c : contents ) {
-        for( const tile_location &loc : c.second ) {
-            battery_tile *battery = active_tiles::furn_at<battery_tile>( loc.absolute );
-            if( battery != nullptr ) {
-                int amt_before_battery = amt;
-                amt = battery->mod_resource( amt );
-                if( cached_amount_here ) {
-                    cached_amount_here = *cached_amount_here + amt_before_battery - amt;
-                }
-                if( amt == 0 ) {
-                    return 0;
-                }
+    for( const tripoint_abs_ms &p : connectors ) {
+        const vehicle_connector_tile *connector = active_tiles::furn_at<vehicle_connector_tile>( p );
+        if( connector == nullptr ) {
+            continue;
+        }
+        for( const tripoint_abs_ms &veh_abs : connector->connected_vehicles ) {
+            vehicle *veh = vehicle::find_vehicle( veh_abs );
+            if( veh == nullptr ) {
+                // TODO: Disconnect
+                debugmsg( "lost vehicle at %s", veh_abs.to_string() );
                 continue;
             }
+            return veh;
+        }
+    }
+    return nullptr;
+}
 
-            if( !recurse ) {
+int distribution_grid::mod_resource( int amt, bool recurse )
+{
+    if( amt == 0 ) {
+        return 0;
+    }
+    const grid_battery_totals &totals = get_battery_totals();
+    // Full batteries can't take more and empty ones can't give any, no need to visit them
+    const bool batteries_can_take = amt > 0 ? totals.stored < totals.capacity : totals.stored > 0;
+    if( batteries_can_take ) {
+        const int amt_before = amt;
+        const std::uint64_t changes_before = battery_tile::change_count;
+        for( const auto &c : batteries ) {
+            submap *sm = mb.lookup_submap( c.first );
+            if( sm == nullptr ) {
                 continue;
             }
-
-            vehicle_connector_tile *connector = active_tiles::furn_at<vehicle_connector_tile>( loc.absolute );
-            if( connector != nullptr ) {
-                for( const tripoint_abs_ms &veh_abs : connector->connected_vehicles ) {
-                    vehicle *veh = vehicle::find_vehicle( veh_abs );
-                    if( veh == nullptr ) {
-                        // TODO: Disconnect
-                        debugmsg( "lost vehicle at %s", veh_abs.to_string() );
-                        continue;
-                    }
-                    connected_vehicles.push_back( veh );
+            for( const tile_location &loc : c.second ) {
+                battery_tile *battery = active_tile_at<battery_tile>( *sm, loc.on_submap );
+                if( battery == nullptr ) {
+                    continue;
+                }
+                amt = battery->mod_resource( amt );
+                if( amt == 0 ) {
+                    break;
                 }
             }
+            if( amt == 0 ) {
+                break;
+            }
+        }
+        // Keeps the totals of this grid and the others of the tracker valid
+        battery_changes->own += battery_tile::change_count - changes_before;
+        battery_totals.stored += amt_before - amt;
+        if( amt == 0 ) {
+            return 0;
         }
     }
 
-    // TODO: Giga ugly. We only charge the first vehicle to get it to use its recursive graph traversal because it's inaccessible from here due to being a template method
-    if( !connected_vehicles.empty() ) {
+    if( !recurse ) {
+        return amt;
+    }
+
+    // The vehicle walks the graph of connected vehicles and grids, which includes the other
+    // vehicles connected to this grid, so it's enough to hand the rest to one of them
+    vehicle *veh = first_connected_vehicle();
+    if( veh != nullptr ) {
         if( amt > 0 ) {
-            amt = connected_vehicles.front()->charge_battery( amt, true );
+            amt = veh->charge_battery( amt, true );
         } else {
-            amt = -connected_vehicles.front()->discharge_battery( -amt, true );
+            amt = -veh->discharge_battery( -amt, true );
         }
     }
 
@@ -121,54 +221,14 @@ int distribution_grid::mod_resource( int amt, bool recurse )
 
 int distribution_grid::get_resource( bool recurse ) const
 {
-    if( !recurse ) {
-        if( cached_amount_here ) {
-            return *cached_amount_here;
-        } else {
-            cached_amount_here = 0;
+    if( recurse ) {
+        // Counts this grid too
+        const vehicle *veh = first_connected_vehicle();
+        if( veh != nullptr ) {
+            return veh->fuel_left( itype_battery, true );
         }
     }
-    int res = 0;
-    std::vector<vehicle *> connected_vehicles;
-    for( const auto &c : contents ) {
-        for( const tile_location &loc : c.second ) {
-            battery_tile *battery = active_tiles::furn_at<battery_tile>( loc.absolute );
-            if( battery != nullptr ) {
-                res += battery->get_resource();
-                if( !recurse && cached_amount_here ) {
-                    cached_amount_here = *cached_amount_here + res;
-                }
-                continue;
-            }
-
-            if( !recurse ) {
-                continue;
-            }
-
-            vehicle_connector_tile *connector = active_tiles::furn_at<vehicle_connector_tile>( loc.absolute );
-            if( connector != nullptr ) {
-                for( const tripoint_abs_ms &veh_abs : connector->connected_vehicles ) {
-                    vehicle *veh = vehicle::find_vehicle( veh_abs );
-                    if( veh == nullptr ) {
-                        // TODO: Disconnect
-                        debugmsg( "lost vehicle at %s", veh_abs.to_string() );
-                        continue;
-                    }
-                    connected_vehicles.push_back( veh );
-                }
-            }
-        }
-    }
-
-    // TODO: Giga ugly. We only charge the first vehicle to get it to use its recursive graph traversal because it's inaccessible from here due to being a template method
-    if( !connected_vehicles.empty() ) {
-        res = connected_vehicles.front()->fuel_left( itype_battery, true );
-    }
-    if( !recurse ) {
-        cached_amount_here = res;
-    }
-
-    return res;
+    return get_battery_totals().stored;
 }
 
 distribution_grid_tracker::distribution_grid_tracker()
@@ -177,6 +237,7 @@ distribution_grid_tracker::distribution_grid_tracker()
 
 distribution_grid_tracker::distribution_grid_tracker( mapbuffer &buffer )
     : mb( buffer )
+    , battery_changes( make_shared_fast<grid_battery_changes>() )
 {
 }
 
@@ -198,7 +259,7 @@ distribution_grid &distribution_grid_tracker::make_distribution_grid_at(
         submap_positions.emplace_back( tp + point_south_east );
     }
     shared_ptr_fast<distribution_grid> dist_grid = make_shared_fast<distribution_grid>
-            ( submap_positions, mb );
+            ( submap_positions, mb, battery_changes );
     for( const tripoint_abs_sm &smp : submap_positions ) {
         shared_ptr_fast<distribution_grid> &old_grid = parent_distribution_grids[smp];
         if( old_grid != dist_grid ) {
@@ -251,11 +312,34 @@ void distribution_grid_tracker::on_changed( const tripoint_abs_ms &p )
     // TODO: If not in bounds, just drop the grid, rebuild lazily
     if( parent_distribution_grids.contains( sm_pos ) ||
         bounds.contains( sm_pos.xy() ) ) {
-        // TODO: Don't rebuild, update
         make_distribution_grid_at( sm_pos );
     }
 }
 
+void distribution_grid_tracker::on_furniture_changed( const tripoint_abs_ms &p )
+{
+    tripoint_abs_sm sm_pos = project_to<coords::sm>( p );
+    auto iter = parent_distribution_grids.find( sm_pos );
+    if( iter == parent_distribution_grids.end() ) {
+        on_changed( p );
+        return;
+    }
+    // The overmap connections are the same, so it's the same grid with different contents
+    const shared_ptr_fast<distribution_grid> &grid = iter->second;
+    grid->on_submap_changed( sm_pos );
+    if( grid->empty() ) {
+        grids_requiring_updates.erase( grid );
+    } else {
+        grids_requiring_updates.emplace( grid );
+    }
+}
+
+bool distribution_grid_tracker::is_active_grid_submap( const tripoint_abs_sm &sm_pos ) const
+{
+    const auto it = parent_distribution_grids.find( sm_pos );
+    return it != parent_distribution_grids.end() && !it->second->empty();
+}
+
 void distribution_grid_tracker::on_options_changed()
 {
     on_saved();
@@ -324,13 +408,13 @@ void grid_furn_transform_queue::apply( mapbuffer &mb, distribution_grid_tracker
         if( old_t.active ) {
             sm->active_furniture.erase( p_within_sm );
             // TODO: Only for g->m? Observer pattern?
-            grid_tracker.on_changed( qt.p );
+            grid_tracker.on_furniture_changed( qt.p );
         }
         if( new_t.active ) {
             active_tile_data *atd = new_t.active->clone();
             atd->set_last_updated( calendar::turn );
             sm->active_furniture[p_within_sm].reset( atd );
-            grid_tracker.on_changed( qt.p );
+            grid_tracker.on_furniture_changed( qt.p );
         }
     }
 }
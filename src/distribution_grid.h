@@ -15,6 +15,8 @@
 class Character;
 class map;
 class mapbuffer;
+class submap;
+class vehicle;
 
 struct tile_location {
     point_sm_ms on_submap;
@@ -26,6 +28,25 @@ struct tile_location {
     {}
 };
 
+/**
+ * Charge and capacity of all the batteries on a grid, in kJ.
+ */
+struct grid_battery_totals {
+    int stored = 0;
+    int capacity = 0;
+};
+
+/**
+ * Battery charge changes made through the grids of one tracker, out of all
+ * @ref battery_tile::change_count. Grids of one tracker don't share batteries, so only
+ * the changes made some other way can make their totals stale.
+ */
+struct grid_battery_changes {
+    std::uint64_t own = 0;
+
+    std::uint64_t foreign() const;
+};
+
 /**
  * A cache that organizes producers, storage and consumers
  * of some resource, like electricity.
@@ -44,12 +65,35 @@ class distribution_grid
         std::vector<tripoint_abs_ms> flat_contents;
         std::vector<tripoint_abs_sm> submap_coords;
 
-        mutable std::optional<int> cached_amount_here;
+        /**
+         * The tiles that take part in moving power around, by submap.
+         * Resource requests only need to look at these, not at every active tile.
+         */
+        std::map<tripoint_abs_sm, std::vector<tile_location>> batteries;
+        std::vector<tripoint_abs_ms> connectors;
+
+        /**
+         * Sum over @ref batteries, valid while @ref grid_battery_changes::foreign is
+         * still @ref battery_totals_at. Changes made by this grid keep it valid.
+         */
+        mutable grid_battery_totals battery_totals;
+        mutable std::uint64_t battery_totals_at = 0;
+        mutable bool battery_totals_valid = false;
+        /** Shared by the grids of the tracker that made this grid */
+        shared_ptr_fast<grid_battery_changes> battery_changes;
 
         mapbuffer &mb;
 
+        void add_submap_contents( const tripoint_abs_sm &sm_coord, submap &sm );
+        const grid_battery_totals &get_battery_totals() const;
+        /** First vehicle connected to the grid, it reaches the rest by itself */
+        vehicle *first_connected_vehicle() const;
+        /** Active furniture on a submap of this grid changed */
+        void on_submap_changed( const tripoint_abs_sm &sm_coord );
+
     public:
-        distribution_grid( const std::vector<tripoint_abs_sm> &global_submap_coords, mapbuffer &buffer );
+        distribution_grid( const std::vector<tripoint_abs_sm> &global_submap_coords, mapbuffer &buffer,
+                           shared_ptr_fast<grid_battery_changes> changes = make_shared_fast<grid_battery_changes>() );
         bool empty() const;
         explicit operator bool() const;
         void update( time_point to );
@@ -58,6 +102,9 @@ class distribution_grid
         const std::vector<tripoint_abs_ms> &get_contents() const {
             return flat_contents;
         }
+
+        /** Times any grid summed up its batteries from scratch, for tests */
+        static std::uint64_t battery_recounts;
 };
 
 class distribution_grid_tracker;
@@ -136,6 +183,8 @@ class distribution_grid_tracker
          */
         std::unordered_set<shared_ptr_fast<distribution_grid>> grids_requiring_updates;
 
+        shared_ptr_fast<grid_battery_changes> battery_changes;
+
     public:
         distribution_grid_tracker();
         distribution_grid_tracker( mapbuffer &buffer );
@@ -170,15 +219,21 @@ class distribution_grid_tracker
         void load( const map &m );
 
         /**
-         * Updates grid at given global map square coordinate.
+         * Rebuilds grid at given global map square coordinate,
+         * for changes in how the overmap tiles are connected.
          */
         void on_changed( const tripoint_abs_ms &p );
+        /**
+         * Updates grid at given global map square coordinate after active furniture
+         * was added or removed there. Only the affected submap is rescanned.
+         */
+        void on_furniture_changed( const tripoint_abs_ms &p );
         void on_saved();
+        /** Whether the submap at @p sm_pos is part of a grid with active furniture */
+        bool is_active_grid_submap( const tripoint_abs_sm &sm_pos ) const;
         void on_options_changed();
 };
 
-class vehicle;
-
 namespace distribution_graph
 {
 enum class traverse_visitor_result {
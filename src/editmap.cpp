@@ -1880,6 +1880,7 @@ void editmap::mapgen_preview( const real_coords &tc, uilist &gmenu )
 
             here.set_transparency_cache_dirty( target.z );
             here.set_outside_cache_dirty( target.z );
+            here.set_scent_cache_dirty( target.z );
             here.set_floor_cache_dirty( target.z );
             here.set_pathfinding_cache_dirty( target.z );
             here.set_suspension_cache_dirty( target.z );
@@ -22,6 +22,7 @@ std::string enum_to_string<event_type>( event_type data )
         case event_type::character_gets_headshot: return "character_gets_headshot";
         case event_type::character_heals_damage: return "character_heals_damage";
         case event_type::character_kills_character: return "character_kills_character";
+        case event_type::character_drops_item: return "character_drops_item";
         case event_type::character_kills_monster: return "character_kills_monster";
         case event_type::character_loses_effect: return "character_loses_effect";
         case event_type::character_takes_damage: return "character_takes_damage";
@@ -92,7 +93,7 @@ constexpr std::array<std::pair<const char *, cata_variant_type>,
 constexpr std::array<std::pair<const char *, cata_variant_type>,
           event_spec_character::fields.size()> event_spec_character::fields;
 
-static_assert( static_cast<int>( event_type::num_event_types ) == 62,
+static_assert( static_cast<int>( event_type::num_event_types ) == 63,
                "This static_assert is a reminder to add a definition below when you add a new "
                "event_type.  If your event_spec specialization inherits from another struct for "
                "its fields definition then you probably don't need a definition here." );
@@ -110,6 +111,7 @@ DEFINE_EVENT_FIELDS( broken_bone_mends )
 DEFINE_EVENT_FIELDS( buries_corpse )
 DEFINE_EVENT_FIELDS( character_gains_effect )
 DEFINE_EVENT_FIELDS( character_heals_damage )
+DEFINE_EVENT_FIELDS( character_drops_item )
 DEFINE_EVENT_FIELDS( character_kills_character )
 DEFINE_EVENT_FIELDS( character_kills_monster )
 DEFINE_EVENT_FIELDS( character_loses_effect )
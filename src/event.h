@@ -36,6 +36,7 @@ enum class event_type {
     character_gets_headshot,
     character_heals_damage,
     character_kills_character,
+    character_drops_item,
     character_kills_monster,
     character_loses_effect,
     character_takes_damage,
@@ -136,7 +137,7 @@ struct event_spec_character {
     };
 };
 
-static_assert( static_cast<int>( event_type::num_event_types ) == 62,
+static_assert( static_cast<int>( event_type::num_event_types ) == 63,
                "This static_assert is to remind you to add a specialization for your new "
                "event_type below" );
 
@@ -225,6 +226,15 @@ struct event_spec<event_type::character_heals_damage> {
     };
 };
 
+template<>
+struct event_spec<event_type::character_drops_item> {
+    static constexpr std::array<std::pair<const char *, cata_variant_type>, 2> fields = {{
+            { "character", cata_variant_type::character_id },
+            { "itype", cata_variant_type::itype_id },
+        }
+    };
+};
+
 template<>
 struct event_spec<event_type::character_kills_monster> {
     static constexpr std::array<std::pair<const char *, cata_variant_type>, 2> fields = {{
@@ -15,6 +15,9 @@ class event_subscriber
         event_subscriber &operator=( const event_subscriber & ) = delete;
         virtual ~event_subscriber();
         virtual void notify( const cata::event & ) = 0;
+        bool is_subscribed() const {
+            return subscribed_to != nullptr;
+        }
     private:
         friend class event_bus;
         void on_subscribe( event_bus * );
@@ -195,8 +195,8 @@ bool field::add_field( const field_type_id &field_type_to_add, const int new_int
         debugmsg( "Tried to add null field" );
         return false;
     }
-    auto it = _field_type_list.find( field_type_to_add );
-    if( it != _field_type_list.end() ) {
+    auto it = _field_type_list.lower_bound( field_type_to_add );
+    if( it != _field_type_list.end() && it->first == field_type_to_add ) {
         // Most fields stack intensities, but some add duration instead
         if( it->first->stacking_type == fields::stacking_type::intensity ) {
             it->second.set_field_intensity( it->second.get_field_intensity() + new_intensity );
@@ -212,7 +212,8 @@ bool field::add_field( const field_type_id &field_type_to_add, const int new_int
         field_type_to_add.obj().priority >= _displayed_field_type.obj().priority ) {
         _displayed_field_type = field_type_to_add;
     }
-    _field_type_list[field_type_to_add] = field_entry( field_type_to_add, new_intensity, new_age );
+    _field_type_list.emplace_hint( it, field_type_to_add,
+                                   field_entry( field_type_to_add, new_intensity, new_age ) );
     return true;
 }
 
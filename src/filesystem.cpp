@@ -30,6 +30,8 @@
 #   include <direct.h>
 #else
 #   include <dirent.h>
+#   include <fcntl.h>
+#   include <sys/mman.h>
 #   include <unistd.h>
 #endif
 
@@ -169,6 +171,41 @@ std::string read_entire_file( const std::string &path )
     return ret;
 }
 
+mapped_file::mapped_file( const std::string &path )
+{
+#if !defined(_WIN32)
+    const int fd = open( path.c_str(), O_RDONLY );
+    if( fd >= 0 ) {
+        struct stat st;
+        if( fstat( fd, &st ) == 0 && S_ISREG( st.st_mode ) && st.st_size > 0 ) {
+            const size_t size = static_cast<size_t>( st.st_size );
+            void *addr = mmap( nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0 );
+            if( addr != MAP_FAILED ) {
+                // Start paging the file in now, callers read all of it anyway.
+                madvise( addr, size, MADV_WILLNEED );
+                mapped = static_cast<const char *>( addr );
+                mapped_size = size;
+            }
+        }
+        close( fd );
+        if( mapped != nullptr ) {
+            return;
+        }
+    }
+#endif
+    // Empty files can't be mapped, and this is also the fallback when mapping fails.
+    contents = read_entire_file( path );
+}
+
+mapped_file::~mapped_file()
+{
+#if !defined(_WIN32)
+    if( mapped != nullptr ) {
+        munmap( const_cast<char *>( mapped ), mapped_size );
+    }
+#endif
+}
+
 namespace
 {
 
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
+#include <string_view>
 #include <vector>
 
 /**
@@ -58,6 +60,29 @@ std::string get_pid_string();
  */
 std::string read_entire_file( const std::string &path );
 
+/**
+ * Read-only contents of an entire file.
+ * The file is memory-mapped where the platform supports it, and read into memory otherwise.
+ * Contents are empty on failure, same as read_entire_file.
+ */
+class mapped_file
+{
+    public:
+        explicit mapped_file( const std::string &path );
+        mapped_file( const mapped_file & ) = delete;
+        mapped_file &operator=( const mapped_file & ) = delete;
+        ~mapped_file();
+
+        std::string_view view() const {
+            return mapped != nullptr ? std::string_view( mapped, mapped_size ) : std::string_view( contents );
+        }
+
+    private:
+        const char *mapped = nullptr;
+        size_t mapped_size = 0;
+        std::string contents;
+};
+
 /** Force 'path' to be a normalized directory */
 std::string as_norm_dir( const std::string &path );
 
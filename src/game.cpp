@@ -240,6 +240,7 @@ static const efftype_id effect_sleep( "sleep" );
 static const efftype_id effect_stunned( "stunned" );
 static const efftype_id effect_tied( "tied" );
 
+static const bionic_id bio_alarm( "bio_alarm" );
 static const bionic_id bio_remote( "bio_remote" );
 static const bionic_id bio_probability_travel( "bio_probability_travel" );
 
@@ -324,6 +325,7 @@ game::game() :
     events().subscribe( &*memorial_logger_ptr );
     events().subscribe( &*achievements_tracker_ptr );
     events().subscribe( &*spell_events_ptr );
+    events().subscribe( &*npc_item_search_events_ptr );
     world_generator = std::make_unique<worldfactory>();
     // do nothing, everything that was in here is moved to init_data() which is called immediately after g = new game; in main.cpp
     // The reason for this move is so that g is not uninitialized when it gets to installing the parts into vehicles.
@@ -1415,6 +1417,9 @@ bool game::do_turn()
         autosave();
     }
 
+    // Keep the map data visited since the last save within the memory budget.
+    MAPBUFFER.enforce_memory_budget();
+
     weather.update_weather();
     reset_light_level();
 
@@ -2741,6 +2746,11 @@ spell_events &game::spell_events_subscriber()
     return *spell_events_ptr;
 }
 
+npc_item_search_events &game::npc_item_search_subscriber()
+{
+    return *npc_item_search_events_ptr;
+}
+
 bool game::save_uistate_data() const
 {
     return get_active_world()->write_to_file( "uistate.json", [&]( std::ostream & fout ) {
@@ -4108,9 +4118,38 @@ void game::monmove()
     ZoneScoped;
     cleanup_dead();
 
+    if( parallel_monster_sight ) {
+        precompute_monster_sight();
+    }
+
+    // The terrain under every monster, looked up in one go before any of them acts.
+    // Monsters still act in the usual order. The lookup is redone for a monster that moved
+    // since, or for everyone once anything changed passability.
+    struct monster_start_tile {
+        const monster *critter;
+        tripoint pos;
+        bool impassable;
+    };
+    std::vector<monster_start_tile> start_tiles;
+    for( const monster &critter : all_monsters() ) {
+        start_tiles.push_back( { &critter, critter.pos(), m.impassable( critter.pos() ) } );
+    }
+    const int64_t start_passability = m.get_passability_generation();
+    size_t start_index = 0;
+
+    const bool new_day = calendar::once_every( 1_days );
     for( monster &critter : all_monsters() ) {
+        bool impassable = false;
+        if( start_index < start_tiles.size() && start_tiles[start_index].critter == &critter &&
+            start_tiles[start_index].pos == critter.pos() &&
+            m.get_passability_generation() == start_passability ) {
+            impassable = start_tiles[start_index].impassable;
+        } else {
+            impassable = m.impassable( critter.pos() );
+        }
+        start_index++;
         // Critters in impassable tiles get pushed away, unless it's not impassable for them
-        if( !critter.is_dead() && m.impassable( critter.pos() ) && !critter.can_move_to( critter.pos() ) ) {
+        if( !critter.is_dead() && impassable && !critter.can_move_to( critter.pos() ) ) {
             std::string msg = string_format( "%s can't move to its location!  %s  %s", critter.name(),
                                              critter.pos().to_string(), m.tername( critter.pos() ) );
             dbg( DL::Error ) << msg;
@@ -4138,7 +4177,7 @@ void game::monmove()
         }
 
         m.creature_in_field( critter );
-        if( calendar::once_every( 1_days ) ) {
+        if( new_day ) {
             if( critter.has_flag( MF_MILKABLE ) ) {
                 critter.refill_udders();
             }
@@ -4156,12 +4195,12 @@ void game::monmove()
             m.creature_in_field( critter );
         }
 
-        const bionic_id bio_alarm( "bio_alarm" );
+        // Cheapest checks first, this runs for every monster
         if( !critter.is_dead() &&
-            u.has_active_bionic( bio_alarm ) &&
-            u.get_power_level() >= bio_alarm->power_trigger &&
             rl_dist( u.pos(), critter.pos() ) <= 5 &&
-            !critter.is_hallucination() ) {
+            !critter.is_hallucination() &&
+            u.has_active_bionic( bio_alarm ) &&
+            u.get_power_level() >= bio_alarm->power_trigger ) {
             u.mod_power_level( -bio_alarm->power_trigger );
             add_msg( m_warning, _( "Your motion alarm goes off!" ) );
             cancel_activity_or_ignore_query( distraction_type::alert,
@@ -4196,6 +4235,7 @@ void game::monmove()
         if( !guy.has_effect( effect_npc_suspend ) ) {
             guy.process_turn();
         }
+        const auto ai_start = std::chrono::steady_clock::now();
         while( !guy.is_dead() && guy.moves > 0 && turns < 10 &&
                ( !guy.in_sleep_state() || guy.activity->id() == ACT_OPERATION )
              ) {
@@ -4222,6 +4262,8 @@ void game::monmove()
             add_msg( _( "%s faints!" ), guy.name );
             guy.reboot();
         }
+        guy.record_ai_time( std::chrono::duration_cast<std::chrono::microseconds>
+                            ( std::chrono::steady_clock::now() - ai_start ) );
 
         if( !guy.is_dead() ) {
             guy.npc_update_body();
@@ -4230,6 +4272,18 @@ void game::monmove()
     cleanup_dead();
 }
 
+void game::precompute_monster_sight()
+{
+    ZoneScoped;
+    std::vector<std::pair<const Creature *, const Creature *>> pairs;
+    for( monster &critter : all_monsters() ) {
+        for( const Creature *target : critter.plan_sight_targets() ) {
+            pairs.emplace_back( &critter, target );
+        }
+    }
+    Creature::precompute_sight( pairs );
+}
+
 void game::overmap_npc_move()
 {
     ZoneScoped;
@@ -12090,6 +12144,28 @@ std::vector<npc *> game::get_npcs_if( const std::function<bool( const npc & )> &
     return result;
 }
 
+std::vector<Creature *> game::creatures_in_radius( const tripoint &center, const int radius,
+        const std::function<bool( const Creature & )> &pred )
+{
+    std::vector<Creature *> result;
+    const auto add = [&]( Creature & critter ) {
+        if( rl_dist( center, critter.pos() ) <= radius && ( !pred || pred( critter ) ) ) {
+            result.push_back( &critter );
+        }
+    };
+    for( monster *critter : critter_tracker->find_in_radius( center, radius ) ) {
+        if( !pred || pred( *critter ) ) {
+            result.push_back( critter );
+        }
+    }
+    // There are few enough of them that an index would not pay for itself.
+    for( npc &guy : all_npcs() ) {
+        add( guy );
+    }
+    add( u );
+    return result;
+}
+
 template<>
 bool game::non_dead_range<monster>::iterator::valid()
 {
@@ -33,6 +33,7 @@ class Creature_tracker;
 class item;
 class monster;
 class spell_events;
+class npc_item_search_events;
 class drop_token_provider;
 
 static constexpr int DEFAULT_TILESET_ZOOM = 16;
@@ -412,6 +413,14 @@ class game
          */
         std::vector<Creature *> get_creatures_if( const std::function<bool( const Creature & )> &pred );
         std::vector<npc *> get_npcs_if( const std::function<bool( const npc & )> &pred );
+        /**
+         * Returns living creatures within @p radius (as per @ref rl_dist) of @p center that match
+         * @p pred (all of them if it's empty), e.g. the members of a faction.
+         * Monsters are looked up in the spatial index of @ref critter_tracker, so this is much
+         * cheaper than @ref get_creatures_if for radii smaller than the reality bubble.
+         */
+        std::vector<Creature *> creatures_in_radius( const tripoint &center, int radius,
+                const std::function<bool( const Creature & )> &pred = nullptr );
         /**
          * Returns a creature matching a predicate. Only living (not dead) creatures
          * are checked. Returns `nullptr` if no creature matches the predicate.
@@ -854,6 +863,8 @@ class game
 
         // Routine loop functions, approximately in order of execution
         void monmove();          // Monster movement
+        // Fill the sight cache for the targets monsters consider, see PARALLEL_MONSTER_SIGHT
+        void precompute_monster_sight();
         void overmap_npc_move(); // NPC overmap movement
         void process_voluntary_act_interrupt(); // Process
         void process_activity(); // Processes and enacts the player's activity
@@ -935,6 +946,7 @@ class game
         pimpl<achievements_tracker> achievements_tracker_ptr;
         pimpl<memorial_logger> memorial_logger_ptr;
         pimpl<spell_events> spell_events_ptr;
+        pimpl<npc_item_search_events> npc_item_search_events_ptr;
         pimpl<distribution_grid_tracker> grid_tracker_ptr;
         pimpl<weather_manager> weather_manager_ptr;
 
@@ -949,6 +961,7 @@ class game
         kill_tracker &get_kill_tracker();
         memorial_logger &memorial();
         spell_events &spell_events_subscriber();
+        npc_item_search_events &npc_item_search_subscriber();
 
         pimpl<Creature_tracker> critter_tracker;
         pimpl<faction_manager> faction_manager_ptr;
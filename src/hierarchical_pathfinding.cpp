@@ -0,0 +1,464 @@
+#include "hierarchical_pathfinding.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <queue>
+#include <set>
+#include <unordered_map>
+#include <utility>
+
+#include "game_constants.h"
+#include "line.h"
+#include "map.h"
+
+decltype( HierarchicalPathfinding::graphs ) HierarchicalPathfinding::graphs = {};
+
+namespace
+{
+
+// Graphs for more settings than this are dropped oldest first
+constexpr size_t max_graphs = 16;
+
+constexpr std::array<point, 8> dirs_2d = {
+    point_north_east, point_north_west, point_south_west, point_south_east,
+    point_east, point_north, point_west, point_south,
+};
+
+constexpr std::array<point, 4> borders = {
+    point_east, point_south, point_west, point_north,
+};
+
+bool is_cluster_inbounds( const point &c )
+{
+    return c.x >= 0 && c.x < MAPSIZE && c.y >= 0 && c.y < MAPSIZE;
+}
+
+point cluster_of( const point &p )
+{
+    return point( p.x / SEEX, p.y / SEEY );
+}
+
+point cluster_origin( const point &c )
+{
+    return point( c.x * SEEX, c.y * SEEY );
+}
+
+// Dijkstra over the tiles of one submap
+struct local_search {
+    point origin;
+    std::array<float, SEEX * SEEY> cost;
+    // Neighbour towards the search start, -1 for none
+    std::array<int, SEEX * SEEY> prev;
+
+    explicit local_search( const point &cluster ) : origin( cluster_origin( cluster ) ) {}
+
+    int index( const point &p ) const {
+        return ( p.y - origin.y ) * SEEX + ( p.x - origin.x );
+    }
+    point at( const int i ) const {
+        return origin + point( i % SEEX, i / SEEX );
+    }
+    bool contains( const point &p ) const {
+        return p.x >= origin.x && p.x < origin.x + SEEX && p.y >= origin.y && p.y < origin.y + SEEY;
+    }
+    float cost_at( const point &p ) const {
+        return cost[index( p )];
+    }
+
+    // Cheapest costs from `from` to every tile, or to `from` from every tile if `reverse`,
+    //   never stepping onto `closed` tiles
+    void run( const PathfindingSettings &settings, const int z, const point &from, const bool reverse,
+              const std::set<tripoint> &closed ) {
+        using entry = std::pair<float, int>;
+        std::priority_queue<entry, std::vector<entry>, std::greater<>> open;
+
+        cost.fill( INFINITY );
+        prev.fill( -1 );
+        cost[index( from )] = 0.0;
+        open.emplace( 0.0, index( from ) );
+        while( !open.empty() ) {
+            const auto [cur_cost, i] = open.top();
+            open.pop();
+            if( cur_cost > cost[i] ) {
+                continue;
+            }
+            const tripoint cur( at( i ), z );
+            for( const point &dir : dirs_2d ) {
+                const point next = cur.xy() + dir;
+                if( !contains( next ) || closed.contains( tripoint( next, z ) ) ) {
+                    continue;
+                }
+                const int j = index( next );
+                const float step = reverse ?
+                                   Pathfinding::step_cost( settings, tripoint( next, z ), cur ) :
+                                   Pathfinding::step_cost( settings, cur, tripoint( next, z ) );
+                const float next_cost = cur_cost + step;
+                if( next_cost < cost[j] ) {
+                    cost[j] = next_cost;
+                    prev[j] = i;
+                    open.emplace( next_cost, j );
+                }
+            }
+        }
+    }
+
+    // Forward search: tiles after the start up to and including `to`
+    void append_path_to( const point &to, const int z, std::vector<tripoint> &out ) const {
+        std::vector<tripoint> reversed;
+        for( int i = index( to ); prev[i] != -1; i = prev[i] ) {
+            reversed.emplace_back( at( i ), z );
+        }
+        out.insert( out.end(), reversed.rbegin(), reversed.rend() );
+    }
+
+    // Reverse search: tiles after `from` up to and including the start
+    void append_path_from( const point &from, const int z, std::vector<tripoint> &out ) const {
+        for( int i = index( from ); prev[i] != -1; ) {
+            i = prev[i];
+            out.emplace_back( at( i ), z );
+        }
+    }
+};
+
+// Crossable tile on the border of a submap and its partner across the border
+struct portal {
+    point pos;
+    point partner;
+    // Cost of stepping from `pos` to `partner`
+    float exit_cost = INFINITY;
+    // Costs of reaching other portals of the same submap, by index
+    std::vector<std::pair<int, float>> intra;
+};
+
+struct cluster {
+    bool dirty = true;
+    std::vector<portal> portals;
+};
+
+// Middles of the runs of tiles that can be crossed both ways on the border of submap `c` towards `dir`
+std::vector<std::pair<point, point>> find_border_portals( const PathfindingSettings &settings,
+                                  const int z, const point &c, const point &dir )
+{
+    if( dir == point_west || dir == point_north ) {
+        // Both sides of a border must agree, so always scan it from the west or north submap
+        std::vector<std::pair<point, point>> ret = find_border_portals( settings, z, c + dir, -dir );
+        for( std::pair<point, point> &pair : ret ) {
+            std::swap( pair.first, pair.second );
+        }
+        return ret;
+    }
+
+    const point origin = cluster_origin( c );
+    const auto border_tile = [&]( const int i ) {
+        return dir == point_east ? origin + point( SEEX - 1, i ) : origin + point( i, SEEY - 1 );
+    };
+
+    std::vector<std::pair<point, point>> ret;
+    int run_start = -1;
+    for( int i = 0; i <= SEEX; i++ ) {
+        bool crossable = false;
+        if( i < SEEX ) {
+            const tripoint a( border_tile( i ), z );
+            const tripoint b = a + dir;
+            crossable = !std::isinf( Pathfinding::step_cost( settings, a, b ) ) &&
+                        !std::isinf( Pathfinding::step_cost( settings, b, a ) );
+        }
+        if( crossable && run_start < 0 ) {
+            run_start = i;
+        } else if( !crossable && run_start >= 0 ) {
+            const point a = border_tile( ( run_start + i - 1 ) / 2 );
+            ret.emplace_back( a, a + dir );
+            run_start = -1;
+        }
+    }
+    return ret;
+}
+
+int find_portal( const cluster &cl, const point &pos )
+{
+    for( size_t i = 0; i < cl.portals.size(); i++ ) {
+        if( cl.portals[i].pos == pos ) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+} // namespace
+
+struct HierarchicalPathfinding::level_graph {
+    int z = 0;
+    PathfindingSettings settings;
+    std::array<cluster, MAPSIZE *MAPSIZE> clusters;
+
+    cluster &at( const point &c ) {
+        return clusters[c.y * MAPSIZE + c.x];
+    }
+
+    // Recompute portals and costs between them if terrain of `c` changed
+    cluster &build( const point &c ) {
+        cluster &cl = at( c );
+        if( !cl.dirty ) {
+            return cl;
+        }
+        cl.portals.clear();
+        for( const point &dir : borders ) {
+            if( !is_cluster_inbounds( c + dir ) ) {
+                continue;
+            }
+            for( const std::pair<point, point> &pair : find_border_portals( settings, z, c, dir ) ) {
+                portal &p = cl.portals.emplace_back();
+                p.pos = pair.first;
+                p.partner = pair.second;
+                p.exit_cost = Pathfinding::step_cost( settings, tripoint( pair.first, z ),
+                                                      tripoint( pair.second, z ) );
+            }
+        }
+        local_search search( c );
+        for( portal &from : cl.portals ) {
+            search.run( settings, z, from.pos, false, {} );
+            for( size_t i = 0; i < cl.portals.size(); i++ ) {
+                const float cost = search.cost_at( cl.portals[i].pos );
+                if( cl.portals[i].pos != from.pos && !std::isinf( cost ) ) {
+                    from.intra.emplace_back( i, cost );
+                }
+            }
+        }
+        cl.dirty = false;
+        return cl;
+    }
+};
+
+HierarchicalPathfinding::level_graph &HierarchicalPathfinding::get_graph( const int z,
+        const PathfindingSettings &settings )
+{
+    auto it = std::ranges::find_if( graphs, [&]( const std::unique_ptr<level_graph> &graph ) {
+        return graph->z == z && graph->settings == settings;
+    } );
+    if( it != graphs.end() ) {
+        return **it;
+    }
+    if( graphs.size() >= max_graphs ) {
+        graphs.erase( graphs.begin() );
+    }
+    std::unique_ptr<level_graph> &graph = graphs.emplace_back( std::make_unique<level_graph>() );
+    graph->z = z;
+    graph->settings = settings;
+    return *graph;
+}
+
+std::vector<tripoint> HierarchicalPathfinding::route( const tripoint &from, const tripoint &to,
+        const PathfindingSettings &path_settings,
+        const std::optional<RouteSettings> &route_settings, const std::set<tripoint> &avoid )
+{
+    const map &here = get_map();
+    const point from_c = cluster_of( from.xy() );
+    const point to_c = cluster_of( to.xy() );
+    if( from.z != to.z || !here.inbounds( from ) || !here.inbounds( to ) ||
+        square_dist( from_c, to_c ) <= 1 ) {
+        // Too close for the submap graph to help
+        if( avoid.empty() ) {
+            return Pathfinding::route( from, to, path_settings, route_settings );
+        }
+        PathfindingSettings avoiding = path_settings;
+        for( const tripoint &p : avoid ) {
+            if( p.z == from.z && p != from && p != to ) {
+                avoiding.extra_g_costs[p.xy()] = INFINITY;
+            }
+        }
+        return Pathfinding::route( from, to, avoiding, route_settings );
+    }
+    if( route_settings && rl_dist_exact( from, to ) > route_settings->max_dist ) {
+        return std::vector<tripoint>();
+    }
+
+    const int z = from.z;
+    PathfindingSettings settings = path_settings;
+    settings.mob_presence_penalty = 0.0;
+    settings.extra_g_costs.clear();
+    level_graph &graph = get_graph( z, settings );
+    // The cached graph doesn't know about `avoid`, it is only respected while searching and refining
+    std::set<tripoint> closed = avoid;
+    closed.erase( from );
+    closed.erase( to );
+
+    const cluster &from_cl = graph.build( from_c );
+    graph.build( to_c );
+    local_search from_search( from_c );
+    from_search.run( settings, z, from.xy(), false, closed );
+    local_search to_search( to_c );
+    to_search.run( settings, z, to.xy(), true, closed );
+
+    // A* over portals, identified by submap and portal index
+    constexpr int portal_bits = 8;
+    const auto key_of = []( const point & c, const int i ) {
+        return ( ( c.y * MAPSIZE + c.x ) << portal_bits ) | i;
+    };
+    const auto portal_of = [&graph]( const int key ) -> portal & {
+        return graph.clusters[key >> portal_bits].portals[key & ( ( 1 << portal_bits ) - 1 )];
+    };
+    // Any step costs at least this much
+    const float min_step = 0.5 * settings.move_cost_coeff;
+    const auto heuristic = [&]( const point & p ) {
+        return min_step * square_dist( p, to.xy() );
+    };
+
+    struct visit {
+        float g;
+        int parent;
+    };
+    std::unordered_map<int, visit> visited;
+    using entry = std::pair<float, int>;
+    std::priority_queue<entry, std::vector<entry>, std::greater<>> open;
+    const auto relax = [&]( const int key, const float g, const int parent ) {
+        if( closed.contains( tripoint( portal_of( key ).pos, z ) ) ) {
+            return;
+        }
+        auto it = visited.find( key );
+        if( it != visited.end() && it->second.g <= g ) {
+            return;
+        }
+        visited[key] = visit{ g, parent };
+        open.emplace( g + heuristic( portal_of( key ).pos ), key );
+    };
+
+    for( size_t i = 0; i < from_cl.portals.size(); i++ ) {
+        const float cost = from_search.cost_at( from_cl.portals[i].pos );
+        if( !std::isinf( cost ) ) {
+            relax( key_of( from_c, i ), cost, -1 );
+        }
+    }
+
+    float best = INFINITY;
+    int best_last = -1;
+    while( !open.empty() ) {
+        const auto [f, key] = open.top();
+        open.pop();
+        if( f >= best ) {
+            break;
+        }
+        const float g = visited[key].g;
+        if( f > g + heuristic( portal_of( key ).pos ) ) {
+            // Stale entry
+            continue;
+        }
+        const point c( ( key >> portal_bits ) % MAPSIZE, ( key >> portal_bits ) / MAPSIZE );
+        const portal &cur = portal_of( key );
+        if( c == to_c ) {
+            const float to_cost = g + to_search.cost_at( cur.pos );
+            if( to_cost < best ) {
+                best = to_cost;
+                best_last = key;
+            }
+        }
+        for( const std::pair<int, float> &edge : cur.intra ) {
+            relax( key_of( c, edge.first ), g + edge.second, key );
+        }
+        const point next_c = cluster_of( cur.partner );
+        const int next_i = find_portal( graph.build( next_c ), cur.partner );
+        if( next_i >= 0 ) {
+            relax( key_of( next_c, next_i ), g + cur.exit_cost, key );
+        }
+    }
+    if( best_last < 0 ) {
+        return std::vector<tripoint>();
+    }
+
+    std::vector<int> portals;
+    for( int key = best_last; key != -1; key = visited[key].parent ) {
+        portals.push_back( key );
+    }
+    std::reverse( portals.begin(), portals.end() );
+
+    // Refine one submap at a time
+    std::vector<tripoint> result;
+    result.push_back( from );
+    from_search.append_path_to( portal_of( portals.front() ).pos, z, result );
+    for( size_t i = 1; i < portals.size(); i++ ) {
+        const point prev_pos = portal_of( portals[i - 1] ).pos;
+        const point pos = portal_of( portals[i] ).pos;
+        if( portal_of( portals[i - 1] ).partner == pos ) {
+            result.emplace_back( pos, z );
+        } else {
+            local_search search( cluster_of( pos ) );
+            search.run( settings, z, prev_pos, false, closed );
+            if( std::isinf( search.cost_at( pos ) ) ) {
+                // Only possible when `avoid` cuts the cached way through this submap
+                return std::vector<tripoint>();
+            }
+            search.append_path_to( pos, z, result );
+        }
+    }
+    to_search.append_path_from( portal_of( portals.back() ).pos, z, result );
+    return result;
+}
+
+void HierarchicalPathfinding::mark_dirty_tile( const tripoint &p )
+{
+    const point c = cluster_of( p.xy() );
+    if( !is_cluster_inbounds( c ) ) {
+        return;
+    }
+    const point local = p.xy() - cluster_origin( c );
+    for( std::unique_ptr<level_graph> &graph : graphs ) {
+        if( graph->z != p.z ) {
+            continue;
+        }
+        graph->at( c ).dirty = true;
+        // Border tiles decide the portals of the neighbour as well
+        for( const point &dir : borders ) {
+            const point edge = local + dir;
+            const bool on_border = edge.x < 0 || edge.x >= SEEX || edge.y < 0 || edge.y >= SEEY;
+            if( on_border && is_cluster_inbounds( c + dir ) ) {
+                graph->at( c + dir ).dirty = true;
+            }
+        }
+    }
+}
+
+void HierarchicalPathfinding::mark_dirty_z_level( const int z )
+{
+    for( std::unique_ptr<level_graph> &graph : graphs ) {
+        if( graph->z == z ) {
+            for( cluster &cl : graph->clusters ) {
+                cl.dirty = true;
+            }
+        }
+    }
+}
+
+void HierarchicalPathfinding::shift( const point sm_shift )
+{
+    const point ms_shift = cluster_origin( sm_shift );
+    for( std::unique_ptr<level_graph> &graph : graphs ) {
+        std::array<cluster, MAPSIZE *MAPSIZE> shifted;
+        for( int y = 0; y < MAPSIZE; y++ ) {
+            for( int x = 0; x < MAPSIZE; x++ ) {
+                const point c( x, y );
+                const point old_c = c + sm_shift;
+                cluster &cl = shifted[y * MAPSIZE + x];
+                // Submaps that got a new neighbour need new portals
+                const bool keep = is_cluster_inbounds( old_c ) &&
+                std::ranges::all_of( borders, [&]( const point & dir ) {
+                    return !is_cluster_inbounds( c + dir ) || is_cluster_inbounds( old_c + dir );
+                } );
+                if( !keep ) {
+                    continue;
+                }
+                cl = std::move( graph->at( old_c ) );
+                for( portal &p : cl.portals ) {
+                    p.pos -= ms_shift;
+                    p.partner -= ms_shift;
+                }
+            }
+        }
+        graph->clusters = std::move( shifted );
+    }
+}
+
+void HierarchicalPathfinding::clear()
+{
+    graphs.clear();
+}
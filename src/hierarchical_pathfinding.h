@@ -0,0 +1,45 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <set>
+#include <vector>
+
+#include "pathfinding.h"
+#include "point.h"
+
+// HPA*-style layer on top of `Pathfinding` for long routes across the reality bubble.
+// Submaps are clusters: we keep the portals (crossable tiles) on the borders between neighbouring
+//   submaps and the costs of moving between portals of the same submap, plan the route on that
+//   graph and only then refine it tile by tile, one submap at a time.
+// Cluster data is kept between turns and only recomputed for submaps whose terrain changed.
+class HierarchicalPathfinding
+{
+    public:
+        // Same as `Pathfinding::route`, but plans on the submap graph when `from` and `to` are on
+        //   the same z-level and further apart than neighbouring submaps.
+        // Transient costs (`mob_presence_penalty`, `extra_g_costs`) are ignored while planning.
+        // Tiles in `avoid` other than `from` and `to` are never stepped on; the route is empty when
+        //   they block the planned way through a submap, even if another way exists.
+        static std::vector<tripoint> route( const tripoint &from, const tripoint &to,
+                                            const PathfindingSettings &path_settings,
+                                            const std::optional<RouteSettings> &route_settings = std::nullopt,
+                                            const std::set<tripoint> &avoid = {} );
+
+        // Terrain or furniture at `p` changed
+        static void mark_dirty_tile( const tripoint &p );
+        // Something not tracked per tile changed on `z` (e.g. a vehicle moved)
+        static void mark_dirty_z_level( int z );
+        // The map moved by `sm_shift` submaps
+        static void shift( point sm_shift );
+        // Forget all cluster data
+        static void clear();
+
+    private:
+        struct level_graph;
+
+        // Global state: one graph per z-level and pathfinding settings
+        static std::vector<std::unique_ptr<level_graph>> graphs;
+
+        static level_graph &get_graph( int z, const PathfindingSettings &settings );
+};
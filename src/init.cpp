@@ -1,14 +1,19 @@
 #include "init.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <deque>
 #include <exception>
 #include <fstream>
+#include <future>
 #include <iterator>
 #include <memory>
 #include <sstream> // for throwing errors
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include "achievement.h"
@@ -63,6 +68,7 @@
 #include "mapgen.h"
 #include "martialarts.h"
 #include "material.h"
+#include "memory_istream.h"
 #include "mission.h"
 #include "mod_manager.h"
 #include "monfaction.h"
@@ -136,24 +142,37 @@ void DynamicDataLoader::load_object( const JsonObject &jo, const std::string &sr
 }
 
 struct DynamicDataLoader::cached_streams {
-    lru_cache<std::string, shared_ptr_fast<std::istringstream>> cache;
+    lru_cache<std::string, shared_ptr_fast<const mapped_file>> cache;
 };
 
+namespace
+{
+
+/** Stream over a cached data file that keeps the file mapped while the stream is in use. */
+class cached_file_stream : public memory_istream
+{
+    public:
+        explicit cached_file_stream( shared_ptr_fast<const mapped_file> f )
+            : memory_istream( f->view() ), file( std::move( f ) ) {}
+
+    private:
+        shared_ptr_fast<const mapped_file> file;
+};
+
+} // namespace
+
 shared_ptr_fast<std::istream> DynamicDataLoader::get_cached_stream( const std::string &path )
 {
     assert( !finalized && "Cannot open data file after finalization." );
     assert( stream_cache && "Stream cache is only available during finalization" );
-    shared_ptr_fast<std::istringstream> cached = stream_cache->cache.get( path, nullptr );
-    // Create a new stream if the file is not opened yet, or if some code is still
-    // using the previous stream (in such case, `cached` and `stream_cache` have
-    // two references to the stream, hence the test for > 2).
+    shared_ptr_fast<const mapped_file> cached = stream_cache->cache.get( path, nullptr );
+    // The file contents are read-only, so every caller gets its own stream over the
+    // same cached contents, even if some code is still using a previous stream.
     if( !cached ) {
-        cached = make_shared_fast<std::istringstream>( read_entire_file( path ) );
-    } else if( cached.use_count() > 2 ) {
-        cached = make_shared_fast<std::istringstream>( cached->str() );
+        cached = make_shared_fast<const mapped_file>( path );
     }
     stream_cache->cache.insert( 8, path, cached );
-    return cached;
+    return make_shared_fast<cached_file_stream>( cached );
 }
 
 void DynamicDataLoader::load_deferred( deferred_json &data )
@@ -486,18 +505,27 @@ void DynamicDataLoader::load_data_from_path( const std::string &path, const std:
             files.push_back( path );
         }
     }
+    // Files are opened (memory-mapped where possible) on worker threads a few files ahead
+    // of the main thread, which parses and loads them strictly in order, so the load order
+    // (and with it how mods override each other) doesn't change.
+    const size_t read_ahead = std::max( 1u, std::thread::hardware_concurrency() );
+    std::deque<std::future<std::unique_ptr<mapped_file>>> pending_reads;
+    size_t next_read = 0;
+    const auto queue_reads = [&]() {
+        while( next_read < files.size() && pending_reads.size() < read_ahead ) {
+            pending_reads.push_back( std::async( std::launch::async, []( const std::string & file ) {
+                return std::make_unique<mapped_file>( file );
+            }, files[next_read] ) );
+            next_read++;
+        }
+    };
     // iterate over each file
     for( auto &files_i : files ) {
         const std::string &file = files_i;
-        // open the file as a stream
-        cata_ifstream infile = std::move( cata_ifstream().mode( cata_ios_mode::binary ).open( file ) );
-        // and stuff it into ram
-        std::istringstream iss(
-            std::string(
-                ( std::istreambuf_iterator<char>( *infile ) ),
-                std::istreambuf_iterator<char>()
-            )
-        );
+        queue_reads();
+        const std::unique_ptr<mapped_file> contents = pending_reads.front().get();
+        pending_reads.pop_front();
+        memory_istream iss( contents->view() );
         try {
             // parse it
             JsonIn jsin( iss, file );
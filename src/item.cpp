@@ -10,11 +10,13 @@
 #include <iterator>
 #include <limits>
 #include <locale>
+#include <map>
 #include <memory>
 #include <optional>
 #include <set>
 #include <sstream>
 #include <tuple>
+#include <unordered_map>
 #include <unordered_set>
 
 #include "advanced_inv.h"
@@ -52,6 +54,7 @@
 #include "game.h"
 #include "game_constants.h"
 #include "gun_mode.h"
+#include "hash_utils.h"
 #include "iexamine.h"
 #include "int_id.h"
 #include "inventory.h"
@@ -6054,6 +6057,26 @@ auto get_hourly_rotpoints_at_temp( const units::temperature temp ) -> int
     return rot_chart[std::round( temp_c )];
 }
 
+namespace
+{
+
+// rot modifier
+float rot_factor( const item &it )
+{
+    if( it.is_corpse() && it.has_flag( flag_FIELD_DRESS ) ) {
+        return 0.75;
+    }
+    return 1.0;
+}
+
+time_duration rot_at_temperature( float factor, const time_duration &time_delta,
+                                  const units::temperature temp )
+{
+    return factor * time_delta / 1_hours * get_hourly_rotpoints_at_temp( temp ) * 1_turns;
+}
+
+} // namespace
+
 auto item::calc_rot( time_point time, const units::temperature temp ) const -> time_duration
 {
     // Avoid needlessly calculating already rotten things.  Corpses should
@@ -6064,11 +6087,7 @@ auto item::calc_rot( time_point time, const units::temperature temp ) const -> t
         return 0_seconds;
     }
 
-    // rot modifier
-    float factor = 1.0;
-    if( is_corpse() && has_flag( flag_FIELD_DRESS ) ) {
-        factor = 0.75;
-    }
+    const float factor = rot_factor( *this );
 
     time_duration added_rot = 0_seconds;
     // simulation of different age of food at the start of the game and good/bad storage
@@ -6079,8 +6098,7 @@ auto item::calc_rot( time_point time, const units::temperature temp ) const -> t
         time_duration spoil_variation = get_shelf_life() * 0.2f;
         added_rot += rng( -spoil_variation, spoil_variation );
     }
-    time_duration time_delta = time - last_rot_check;
-    added_rot += factor * time_delta / 1_hours * get_hourly_rotpoints_at_temp( temp ) * 1_turns;
+    added_rot += rot_at_temperature( factor, time - last_rot_check, temp );
     return added_rot;
 }
 
@@ -9530,6 +9548,94 @@ static units::temperature clip_by_temperature_flag( units::temperature temperatu
     return temperature;
 }
 
+namespace
+{
+
+// The hour by hour steps an item left out of the reality bubble catches up on rot with.
+// They depend only on where and how it was stored and when it was last processed,
+// so all the items stored (and processed) together share them: a freezer full of food
+// generates its weather and sums its rot once, not once per item.
+struct rot_timeline {
+    time_point start;
+    // End of each step
+    std::vector<time_point> times;
+    // Environment temperature of each step, clipped by the storage
+    std::vector<units::temperature> temperatures;
+    // Running totals of the rot added by the steps per rot factor:
+    // element `i` is the rot added by the first `i` steps
+    std::map<float, std::vector<time_duration>> rot_sums;
+
+    const std::vector<time_duration> &get_rot_sums( float factor ) {
+        auto it = rot_sums.find( factor );
+        if( it == rot_sums.end() ) {
+            std::vector<time_duration> sums;
+            sums.reserve( times.size() + 1 );
+            sums.push_back( 0_turns );
+            time_point prev = start;
+            for( size_t i = 0; i < times.size(); i++ ) {
+                sums.push_back( sums.back() + rot_at_temperature( factor, times[i] - prev, temperatures[i] ) );
+                prev = times[i];
+            }
+            it = rot_sums.emplace( factor, std::move( sums ) ).first;
+        }
+        return it->second;
+    }
+};
+
+// location, storage, local temperature modifier (in millidegrees), last rot check (in turns)
+using rot_timeline_key = std::tuple<tripoint, int, int, int>;
+
+struct rot_timeline_cache {
+    time_point turn = calendar::before_time_starts;
+    unsigned seed = 0;
+    std::unordered_map<rot_timeline_key, rot_timeline, cata::tuple_hash> timelines;
+};
+
+// Timelines end at the current turn, so they're only shared within a turn
+rot_timeline &get_rot_timeline( const weather_manager &weather, const tripoint_abs_ms &location,
+                                units::temperature local_mod, temperature_flag flag,
+                                const time_point &start )
+{
+    // Bounds memory use when a lot of submaps are loaded in a single turn
+    static constexpr size_t max_cached = 1 << 12;
+    static rot_timeline_cache cache;
+
+    const time_point now = calendar::turn;
+    if( cache.turn != now || cache.seed != g->get_seed() || cache.timelines.size() >= max_cached ) {
+        cache.timelines.clear();
+        cache.turn = now;
+        cache.seed = g->get_seed();
+    }
+
+    const rot_timeline_key key( location.raw(), static_cast<int>( flag ),
+                                units::to_millidegree_celsius( local_mod ), to_turn<int>( start ) );
+    auto it = cache.timelines.find( key );
+    if( it != cache.timelines.end() ) {
+        return it->second;
+    }
+
+    rot_timeline timeline;
+    timeline.start = start;
+    time_point time = start;
+    while( now - time > 1_hours ) {
+        time_duration time_delta = std::min( 1_hours, now - 1_hours - time );
+        time += time_delta;
+
+        //Use weather if above ground, use map temp if below
+        units::temperature env_temperature_raw;
+        if( location.z() >= 0 ) {
+            env_temperature_raw = weather.get_past_temperature( location, time ) + local_mod;
+        } else {
+            env_temperature_raw = temperatures::annual_average + local_mod;
+        }
+        timeline.times.push_back( time );
+        timeline.temperatures.push_back( clip_by_temperature_flag( env_temperature_raw, flag ) );
+    }
+    return cache.timelines.emplace( key, std::move( timeline ) ).first->second;
+}
+
+} // namespace
+
 detached_ptr<item>  item::process_rot( detached_ptr<item> &&self, const bool seals,
                                        const tripoint &pos,
                                        player *carrier, const temperature_flag flag,
@@ -9559,42 +9665,70 @@ detached_ptr<item>  item::process_rot( detached_ptr<item> &&self, const bool sea
 
     if( now - time > 1_hours ) {
         // This code is for items that were left out of reality bubble for long time
-
-        const weather_generator &wgen = weather.get_cur_weather_gen();
-        const unsigned int seed = g->get_seed();
+        const tripoint_abs_ms location( get_map().getabs( pos ) );
         // It's a modifier, so we need to subtract 0_f
         units::temperature local_mod = units::from_fahrenheit( g->new_game
                                        ? 0
                                        : get_map().get_temperature( pos ) ) - 0_f;
 
-        // Process the past of this item since the last time it was processed
-        while( now - time > 1_hours ) {
-            // Get the environment temperature
-            time_duration time_delta = std::min( 1_hours, now - 1_hours - time );
-            time += time_delta;
-
-            //Use weather if above ground, use map temp if below
-            units::temperature env_temperature_raw;
-            if( pos.z >= 0 ) {
-                tripoint_abs_ms location = tripoint_abs_ms( get_map().getabs( pos ) );
-                units::temperature weather_temperature = wgen.get_weather_temperature( location, time,
-                        calendar::config, seed );
-                env_temperature_raw = weather_temperature + local_mod;
-            } else {
-                env_temperature_raw = temperatures::annual_average + local_mod;
+        rot_timeline &timeline = get_rot_timeline( weather, location, local_mod, flag, time );
+        const size_t num_steps = timeline.times.size();
+        const bool can_rot_away = carrier == nullptr && !seals;
+        // Rot only grows, so instead of adding it step by step and checking whether the item
+        // rotted away after every step, the step that ends it can be searched for.
+        // Items from before the cataclysm get their starting variation on the first step,
+        // the few items that don't spoil or rot away in the usual way are done step by step.
+        const bool is_corpse = self->is_corpse();
+        const bool search_steps = self->goes_bad() &&
+                                  self->last_rot_check > calendar::start_of_cataclysm &&
+                                  !( is_corpse && self->can_revive() && self->is_food() );
+        if( !search_steps ) {
+            for( size_t step = 0; step < num_steps; step++ ) {
+                self->rot += self->calc_rot( timeline.times[step], timeline.temperatures[step] );
+                self->last_rot_check = timeline.times[step];
+
+                if( self->has_rotten_away() && can_rot_away ) {
+                    // No need to track item that will be gone
+                    return detached_ptr<item>();
+                }
+            }
+        } else {
+            const std::vector<time_duration> &rot_sums = timeline.get_rot_sums( rot_factor( *self ) );
+            const time_duration start_rot = self->rot;
+            // Index of the step after which the item is gone, or num_steps if it makes it through
+            size_t rotten_at = num_steps;
+            // Number of steps that added rot
+            size_t rotting_steps = num_steps;
+            if( !is_corpse ) {
+                // Food stops rotting at twice its shelf life (see calc_rot) and rots away right then
+                const time_duration shelf_life = self->get_shelf_life();
+                const auto first_too_rotten = std::partition_point( rot_sums.begin(), rot_sums.end(),
+                [&]( const time_duration & sum ) {
+                    return !( ( start_rot + sum ) / shelf_life > 2.0 );
+                } );
+                rotting_steps = first_too_rotten - rot_sums.begin();
+                if( rotting_steps <= num_steps && can_rot_away ) {
+                    rotten_at = std::max<size_t>( rotting_steps, 1 ) - 1;
+                }
+                rotting_steps = std::min( rotting_steps, num_steps );
+            } else if( can_rot_away && !self->can_revive() ) {
+                // Corpses rot away after 10 days
+                const auto rotten = std::upper_bound( rot_sums.begin() + 1, rot_sums.end(),
+                                                      10_days - start_rot );
+                if( rotten != rot_sums.end() ) {
+                    rotting_steps = rotten - rot_sums.begin();
+                    rotten_at = rotting_steps - 1;
+                }
             }
 
-            units::temperature env_temperature_clipped = clip_by_temperature_flag( env_temperature_raw, flag );
-
-            // Calculate item rot
-            self->rot += self->calc_rot( time, env_temperature_clipped );
-            self->last_rot_check = time;
-
-            if( self->has_rotten_away() && carrier == nullptr && !seals ) {
-                // No need to track item that will be gone
+            self->rot = start_rot + rot_sums[rotting_steps];
+            if( rotten_at < num_steps ) {
+                self->last_rot_check = timeline.times[rotten_at];
                 return detached_ptr<item>();
             }
+            self->last_rot_check = timeline.times.back();
         }
+        time = self->last_rot_check;
     }
 
     // Remaining <1 h from above
@@ -10203,6 +10337,10 @@ detached_ptr<item> item::process_tool( detached_ptr<item> &&self, player *carrie
         // If no revert is defined, destroy it (candles and the like).
         if( self->is_active() && self->revert( carrier ) ) {
             self->deactivate();
+            if( carrier != nullptr ) {
+                // Running out of power may turn off gear that hides or helps seeing, like optical cloaks
+                carrier->recalc_sight_limits();
+            }
             return std::move( self );
         } else {
             return detached_ptr<item>();
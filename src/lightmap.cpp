@@ -1,7 +1,10 @@
 #include "lightmap.h" // IWYU pragma: associated
 #include "shadowcasting.h" // IWYU pragma: associated
 
+#include <array>
+#include <bitset>
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <memory>
@@ -79,6 +82,54 @@ struct transparency_exp_lookup {
     }
 };
 
+namespace
+{
+
+// std::exp( -( transparency * distance ) ) by distance, for one transparency
+struct sight_exp_table {
+    float transparency = 0.0f;
+    std::bitset<90> filled;
+    std::array<float, 90> values;
+};
+
+// The recursion keeps coming back to the transparencies of the rows it split off from,
+// so a few of them are kept at once. Casts run on several threads.
+constexpr int sight_exp_table_bits = 4;
+thread_local std::array<sight_exp_table, 1 << sight_exp_table_bits> sight_exp_tables;
+
+} // namespace
+
+float sight_calc_from_table( const float &numerator, const float &transparency,
+                             const int &distance )
+{
+    if( distance < 0 || distance >= 90 ) {
+        return sight_calc( numerator, transparency, distance );
+    }
+    uint32_t bits;
+    std::memcpy( &bits, &transparency, sizeof( bits ) );
+    sight_exp_table &table = sight_exp_tables[( bits * 2654435761u ) >> ( 32 - sight_exp_table_bits )];
+    if( table.transparency != transparency ) {
+        table.transparency = transparency;
+        table.filled.reset();
+    }
+    if( !table.filled[distance] ) {
+        table.values[distance] = std::exp( -( transparency * distance ) );
+        table.filled.set( distance );
+    }
+    return numerator * table.values[distance];
+}
+
+// calc, going through the exp tables for sight_calc
+template<typename T, T( *calc )( const T &, const T &, const int & )>
+static inline T calc_intensity( const T &numerator, const T &transparency, const int &distance )
+{
+    if constexpr( calc == &sight_calc ) {
+        return sight_calc_from_table( numerator, transparency, distance );
+    } else {
+        return calc( numerator, transparency, distance );
+    }
+}
+
 //These are used for shadowcasting fast paths, openair is constant, weather is replaced every time the weather changes.
 //They are 90 entries large to comfortably account for shadowcasting's limit of 60*sqrt(2).
 const transparency_exp_lookup<90> openair_transparency_lookup( LIGHT_TRANSPARENCY_OPEN_AIR );
@@ -101,6 +152,16 @@ void map::add_light_from_items( const tripoint &p, const item_stack::iterator &b
     }
 }
 
+void map::update_weather_transparency_lookup()
+{
+    const float sight_penalty = get_weather().weather_id->sight_penalty;
+
+    if( sight_penalty != 1.0f &&
+        LIGHT_TRANSPARENCY_OPEN_AIR * sight_penalty != weather_transparency_lookup.transparency ) {
+        weather_transparency_lookup.reset( LIGHT_TRANSPARENCY_OPEN_AIR * sight_penalty );
+    }
+}
+
 // TODO: Consider making this just clear the cache and dynamically fill it in as is_transparent() is called
 bool map::build_transparency_cache( const int zlev )
 {
@@ -125,10 +186,7 @@ bool map::build_transparency_cache( const int zlev )
 
     const float sight_penalty = get_weather().weather_id->sight_penalty;
 
-    if( sight_penalty != 1.0f &&
-        LIGHT_TRANSPARENCY_OPEN_AIR * sight_penalty != weather_transparency_lookup.transparency ) {
-        weather_transparency_lookup.reset( LIGHT_TRANSPARENCY_OPEN_AIR * sight_penalty );
-    }
+    update_weather_transparency_lookup();
 
     // Traverse the submaps in order
     for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
@@ -635,16 +693,22 @@ void map::generate_lightmap( const int zlev )
         unbuffered: (12^2)*(160*4) = apply_light_ray x 92160
         buffered:   (12*4)*(160)   = apply_light_ray x 7680
     */
-    const tripoint cache_start( 0, 0, zlev );
-    const tripoint cache_end( LIGHTMAP_CACHE_X, LIGHTMAP_CACHE_Y, zlev );
-    for( const tripoint &p : points_in_rectangle( cache_start, cache_end ) ) {
-        if( light_source_buffer[p.x][p.y] > 0.0 ) {
-            apply_light_source( p, light_source_buffer[p.x][p.y] );
+    // Light cast from the buffer only depends on the buffer and transparency, so it is kept in a
+    // separate layer that is updated incrementally and merged in. Light only ever combines by max,
+    // so this is the same as casting it on top of everything else.
+    update_static_lightmap( zlev );
+    const auto &static_lm = map_cache.static_lm;
+    const auto &static_sm = map_cache.static_sm;
+    for( int x = 0; x < LIGHTMAP_CACHE_X; x++ ) {
+        for( int y = 0; y < LIGHTMAP_CACHE_Y; y++ ) {
+            lm[x][y] = elementwise_max( lm[x][y], static_lm[x][y] );
+            sm[x][y] = std::max( sm[x][y], static_sm[x][y] );
         }
     }
     for( const std::pair<tripoint, float> &elem : lm_override ) {
         lm[elem.first.x][elem.first.y].fill( elem.second );
     }
+    Creature::invalidate_sight_cache();
 }
 
 void map::add_light_source( const tripoint &p, float luminance )
@@ -952,6 +1016,10 @@ void cast_zlight_segment(
         bool started_block = false;
         T current_transparency = 0.0f;
         bool current_floor = false;
+        // cumulative_transparency is fixed for the whole row and most tiles of a row share
+        // their distance, so only call calc (and its exp) when the distance changes.
+        int row_dist = -1;
+        T row_intensity = 0.0f;
 
         int z_start = z_skip != -1 ? z_skip : std::max( 0,
                       static_cast<int>( std::ceil( ( ( distance - 0.5f ) * start_major ) - 0.5f ) ) );
@@ -1006,7 +1074,11 @@ void cast_zlight_segment(
                 }
 
                 const int dist = rl_dist( tripoint_zero, delta ) + offset_distance;
-                T last_intensity = calc( numerator, cumulative_transparency, dist );
+                if( dist != row_dist ) {
+                    row_intensity = calc_intensity<T, calc>( numerator, cumulative_transparency, dist );
+                    row_dist = dist;
+                }
+                T last_intensity = row_intensity;
                 ( *output_caches[z_index] )[current.x][current.y] =
                     std::max( ( *output_caches[z_index] )[current.x][current.y], last_intensity );
 
@@ -1284,7 +1356,7 @@ void castLight( Out( &output_cache )[MAPSIZE_X][MAPSIZE_Y],
                 const int dist = rl_dist( tripoint_zero, delta ) + offsetDistance;
                 //Only avoid recalculation on the slow path, it's faster to avoid the branch on the fast path
                 if( last_dist != dist ) {
-                    last_intensity = calc( numerator, cumulative_transparency, dist );
+                    last_intensity = calc_intensity<T, calc>( numerator, cumulative_transparency, dist );
                     last_dist = dist;
                 }
             }
@@ -1748,18 +1820,16 @@ static float light_from_lookup( const float &numerator, const float &transparenc
     return numerator *  transparency  / distance ;
 }
 
-void map::apply_light_source( const tripoint &p, float luminance )
+// Casts a circular light into the given output arrays. Neighbouring bulk sources
+// in light_source_buffer that are at least as bright suppress the rays towards them.
+static void cast_light_source( four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y],
+                               float ( &sm )[MAPSIZE_X][MAPSIZE_Y],
+                               const float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y],
+                               const float ( &light_source_buffer )[MAPSIZE_X][MAPSIZE_Y],
+                               const diagonal_blocks( &blocked_cache )[MAPSIZE_X][MAPSIZE_Y],
+                               const point &p2, bool light_center, float luminance )
 {
-    auto &cache = get_cache( p.z );
-    four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y] = cache.lm;
-    float ( &sm )[MAPSIZE_X][MAPSIZE_Y] = cache.sm;
-    float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y] = cache.transparency_cache;
-    float ( &light_source_buffer )[MAPSIZE_X][MAPSIZE_Y] = cache.light_source_buffer;
-    diagonal_blocks( &blocked_cache )[MAPSIZE_X][MAPSIZE_Y] = cache.vehicle_obscured_cache;
-
-    const point p2( p.xy() );
-
-    if( inbounds( p ) ) {
+    if( light_center ) {
         const float min_light = std::max( static_cast<float>( lit_level::LOW ), luminance );
         lm[p2.x][p2.y] = elementwise_max( lm[p2.x][p2.y], min_light );
         sm[p2.x][p2.y] = std::max( sm[p2.x][p2.y], luminance );
@@ -1829,6 +1899,233 @@ void map::apply_light_source( const tripoint &p, float luminance )
     }
 }
 
+void map::apply_light_source( const tripoint &p, float luminance )
+{
+    auto &cache = get_cache( p.z );
+    cast_light_source( cache.lm, cache.sm, cache.transparency_cache, cache.light_source_buffer,
+                       cache.vehicle_obscured_cache, p.xy(), inbounds( p ), luminance );
+}
+
+namespace
+{
+// Set of lightmap tiles built from points and rectangles, answering
+// "is any tile of this rectangle in the set" in constant time.
+class lightmap_region
+{
+    public:
+        lightmap_region() : marks( ( LIGHTMAP_CACHE_X + 1 ) * ( LIGHTMAP_CACHE_Y + 1 ), 0 ) {}
+
+        // Both corners inclusive, clamped to the lightmap
+        void mark( const point &min, const point &max ) {
+            const point lo( std::max( min.x, 0 ), std::max( min.y, 0 ) );
+            const point hi( std::min( max.x, LIGHTMAP_CACHE_X - 1 ) + 1,
+                            std::min( max.y, LIGHTMAP_CACHE_Y - 1 ) + 1 );
+            if( lo.x >= hi.x || lo.y >= hi.y ) {
+                return;
+            }
+            marks[index( lo.x, lo.y )]++;
+            marks[index( hi.x, lo.y )]--;
+            marks[index( lo.x, hi.y )]--;
+            marks[index( hi.x, hi.y )]++;
+            empty = false;
+        }
+
+        void mark( const point &p ) {
+            mark( p, p );
+        }
+
+        // Must be called after marking and before querying
+        void finalize() {
+            if( empty ) {
+                return;
+            }
+            // Integrate the corner marks into per tile coverage counts...
+            for( int x = 0; x < LIGHTMAP_CACHE_X; x++ ) {
+                for( int y = 0; y < LIGHTMAP_CACHE_Y; y++ ) {
+                    int &covered = marks[index( x, y )];
+                    if( x > 0 ) {
+                        covered += marks[index( x - 1, y )];
+                    }
+                    if( y > 0 ) {
+                        covered += marks[index( x, y - 1 )];
+                    }
+                    if( x > 0 && y > 0 ) {
+                        covered -= marks[index( x - 1, y - 1 )];
+                    }
+                }
+            }
+            // ...and those into a summed-area table of covered tiles, shifted by one so that
+            // sums[x][y] is the number of covered tiles in [0, x) x [0, y)
+            std::vector<int> sums( marks.size(), 0 );
+            for( int x = 0; x < LIGHTMAP_CACHE_X; x++ ) {
+                for( int y = 0; y < LIGHTMAP_CACHE_Y; y++ ) {
+                    const int covered = marks[index( x, y )] > 0 ? 1 : 0;
+                    sums[index( x + 1, y + 1 )] = covered + sums[index( x, y + 1 )] +
+                                                  sums[index( x + 1, y )] - sums[index( x, y )];
+                }
+            }
+            marks = std::move( sums );
+        }
+
+        bool is_empty() const {
+            return empty;
+        }
+
+        int count() const {
+            return empty ? 0 : marks[index( LIGHTMAP_CACHE_X, LIGHTMAP_CACHE_Y )];
+        }
+
+        bool contains( const point &p ) const {
+            return any_in( p, p );
+        }
+
+        bool any_in( const point &min, const point &max ) const {
+            if( empty ) {
+                return false;
+            }
+            const point lo( std::max( min.x, 0 ), std::max( min.y, 0 ) );
+            const point hi( std::min( max.x, LIGHTMAP_CACHE_X - 1 ) + 1,
+                            std::min( max.y, LIGHTMAP_CACHE_Y - 1 ) + 1 );
+            if( lo.x >= hi.x || lo.y >= hi.y ) {
+                return false;
+            }
+            return marks[index( hi.x, hi.y )] - marks[index( lo.x, hi.y )] -
+                   marks[index( hi.x, lo.y )] + marks[index( lo.x, lo.y )] > 0;
+        }
+
+    private:
+        static int index( int x, int y ) {
+            return x * ( LIGHTMAP_CACHE_Y + 1 ) + y;
+        }
+
+        std::vector<int> marks;
+        bool empty = true;
+};
+} // namespace
+
+// Upper bound of how far light cast by a bulk source can reach, plus one tile for the
+// diagonal vehicle blocks read next to lit tiles.
+// Light falls off at least as luminance / distance and casting stops after the first row
+// that is too dark.
+static int static_light_reach( float luminance )
+{
+    if( luminance <= lit_level::LOW ) {
+        return 0;
+    }
+    return std::min( 60, static_cast<int>( std::ceil( luminance / LIGHT_AMBIENT_LOW ) ) + 2 ) + 1;
+}
+
+void map::update_static_lightmap( const int zlev )
+{
+    ZoneScoped;
+    auto &map_cache = get_cache( zlev );
+    auto &static_lm = map_cache.static_lm;
+    auto &static_sm = map_cache.static_sm;
+    auto &prev_sources = map_cache.static_light_sources;
+    auto &prev_transparency = map_cache.static_light_transparency;
+    auto &prev_blocked = map_cache.static_light_blocked;
+    const auto &light_source_buffer = map_cache.light_source_buffer;
+    const auto &transparency_cache = map_cache.transparency_cache;
+    const auto &blocked_cache = map_cache.vehicle_obscured_cache;
+
+    bool rebuild_all = !map_cache.static_light_valid ||
+                       map_cache.static_light_weather_transparency != weather_transparency_lookup.transparency;
+
+    lightmap_region recast_area;
+    if( !rebuild_all ) {
+        lightmap_region changed_transparency;
+        lightmap_region changed_sources;
+        for( int x = 0; x < LIGHTMAP_CACHE_X; x++ ) {
+            for( int y = 0; y < LIGHTMAP_CACHE_Y; y++ ) {
+                if( transparency_cache[x][y] != prev_transparency[x][y] ||
+                    blocked_cache[x][y].nw != prev_blocked[x][y].nw ||
+                    blocked_cache[x][y].ne != prev_blocked[x][y].ne ) {
+                    changed_transparency.mark( point( x, y ) );
+                }
+                if( light_source_buffer[x][y] != prev_sources[x][y] ) {
+                    changed_sources.mark( point( x, y ) );
+                }
+            }
+        }
+        changed_transparency.finalize();
+        changed_sources.finalize();
+        if( changed_transparency.is_empty() && changed_sources.is_empty() ) {
+            return;
+        }
+
+        // A source has to be recast if it changed, if a neighbour that may suppress its rays changed
+        // or if light it casts can pass through a tile with changed transparency.
+        // Both its old and new light are cleared.
+        for( int x = 0; x < LIGHTMAP_CACHE_X; x++ ) {
+            for( int y = 0; y < LIGHTMAP_CACHE_Y; y++ ) {
+                const float luminance = std::max( light_source_buffer[x][y], prev_sources[x][y] );
+                if( luminance <= 0.0f ) {
+                    continue;
+                }
+                const point p( x, y );
+                const int reach = static_light_reach( luminance );
+                const point reach_min = p - point( reach, reach );
+                const point reach_max = p + point( reach, reach );
+                if( changed_sources.any_in( p - point_south_east, p + point_south_east ) ||
+                    changed_transparency.any_in( reach_min, reach_max ) ) {
+                    recast_area.mark( reach_min, reach_max );
+                }
+            }
+        }
+        recast_area.finalize();
+        if( recast_area.is_empty() ) {
+            std::copy_n( &light_source_buffer[0][0], LIGHTMAP_CACHE_X * LIGHTMAP_CACHE_Y,
+                         &prev_sources[0][0] );
+            std::copy_n( &transparency_cache[0][0], LIGHTMAP_CACHE_X * LIGHTMAP_CACHE_Y,
+                         &prev_transparency[0][0] );
+            std::copy_n( &blocked_cache[0][0], LIGHTMAP_CACHE_X * LIGHTMAP_CACHE_Y, &prev_blocked[0][0] );
+            return;
+        }
+        // Past this point tracking the changes costs more than it saves
+        rebuild_all = recast_area.count() > LIGHTMAP_CACHE_X * LIGHTMAP_CACHE_Y / 2;
+    }
+
+    constexpr four_quadrants four_zeros( 0.0f );
+    if( rebuild_all ) {
+        std::fill_n( &static_lm[0][0], LIGHTMAP_CACHE_X * LIGHTMAP_CACHE_Y, four_zeros );
+        std::fill_n( &static_sm[0][0], LIGHTMAP_CACHE_X * LIGHTMAP_CACHE_Y, 0.0f );
+    } else {
+        for( int x = 0; x < LIGHTMAP_CACHE_X; x++ ) {
+            for( int y = 0; y < LIGHTMAP_CACHE_Y; y++ ) {
+                if( recast_area.contains( point( x, y ) ) ) {
+                    static_lm[x][y] = four_zeros;
+                    static_sm[x][y] = 0.0f;
+                }
+            }
+        }
+    }
+
+    // Light only combines by max, so recasting a source that didn't change restores
+    // its light inside of the cleared area and leaves everything else as it was.
+    for( int x = 0; x < LIGHTMAP_CACHE_X; x++ ) {
+        for( int y = 0; y < LIGHTMAP_CACHE_Y; y++ ) {
+            const float luminance = light_source_buffer[x][y];
+            if( luminance <= 0.0f ) {
+                continue;
+            }
+            const point p( x, y );
+            const int reach = static_light_reach( luminance );
+            if( rebuild_all || recast_area.any_in( p - point( reach, reach ), p + point( reach, reach ) ) ) {
+                cast_light_source( static_lm, static_sm, transparency_cache, light_source_buffer,
+                                   blocked_cache, p, true, luminance );
+            }
+        }
+    }
+
+    std::copy_n( &light_source_buffer[0][0], LIGHTMAP_CACHE_X * LIGHTMAP_CACHE_Y,
+                 &prev_sources[0][0] );
+    std::copy_n( &transparency_cache[0][0], LIGHTMAP_CACHE_X * LIGHTMAP_CACHE_Y,
+                 &prev_transparency[0][0] );
+    std::copy_n( &blocked_cache[0][0], LIGHTMAP_CACHE_X * LIGHTMAP_CACHE_Y, &prev_blocked[0][0] );
+    map_cache.static_light_weather_transparency = weather_transparency_lookup.transparency;
+    map_cache.static_light_valid = true;
+}
+
 void map::apply_directional_light( const tripoint &p, int direction, float luminance )
 {
     const point p2( p.xy() );
@@ -1,76 +1,202 @@
 #include "lru_cache.h"
 
+#include <algorithm>
 #include <cstddef>
-#include <sstream>
-#include <iterator>
+#include <functional>
 #include <string>
 
+#include "filesystem.h"
 #include "memory_fast.h"
 #include "point.h"
 
+// Tables are kept at most half full of live entries and three quarters full
+// including deleted ones, so probe sequences stay short.
+static constexpr size_t min_capacity = 16;
+
+template<typename Key, typename Value>
+size_t lru_cache<Key, Value>::find( const Key &pos ) const
+{
+    if( slots.empty() ) {
+        return slots.size();
+    }
+    const size_t mask = slots.size() - 1;
+    for( size_t i = std::hash<Key>()( pos ) & mask; ; i = ( i + 1 ) & mask ) {
+        const slot &s = slots[i];
+        if( s.state == slot_state::empty ) {
+            return slots.size();
+        }
+        if( s.state == slot_state::full && s.key == pos ) {
+            return i;
+        }
+    }
+}
+
 template<typename Key, typename Value>
 Value lru_cache<Key, Value>::get( const Key &pos, const Value &default_ ) const
 {
-    auto found = map.find( pos );
-    if( found != map.end() ) {
-        return found->second->second;
+    const size_t found = find( pos );
+    if( found != slots.size() ) {
+        counters.hits++;
+        slots[found].referenced = true;
+        return slots[found].value;
     }
+    counters.misses++;
     return default_;
 }
 
+template<typename Key, typename Value>
+void lru_cache<Key, Value>::erase_slot( slot &s )
+{
+    s.state = slot_state::deleted;
+    s.referenced = false;
+    // Release whatever the entry holds right away
+    s.key = Key();
+    s.value = Value();
+    used--;
+    deleted++;
+}
+
 template<typename Key, typename Value>
 void lru_cache<Key, Value>::remove( const Key &pos )
 {
-    auto found = map.find( pos );
-    if( found != map.end() ) {
-        ordered_list.erase( found->second );
-        map.erase( found );
+    const size_t found = find( pos );
+    if( found != slots.size() ) {
+        erase_slot( slots[found] );
     }
 }
 
 template<typename Key, typename Value>
-void lru_cache<Key, Value>::insert( int limit, const Key &pos, const Value &t )
+void lru_cache<Key, Value>::evict_one()
+{
+    // Terminates within two sweeps: the first one clears every reference mark
+    const size_t mask = slots.size() - 1;
+    while( true ) {
+        slot &s = slots[clock_hand];
+        clock_hand = ( clock_hand + 1 ) & mask;
+        if( s.state != slot_state::full ) {
+            continue;
+        }
+        if( s.referenced ) {
+            s.referenced = false;
+            continue;
+        }
+        erase_slot( s );
+        counters.evictions++;
+        return;
+    }
+}
+
+template<typename Key, typename Value>
+void lru_cache<Key, Value>::rehash( size_t capacity )
 {
-    auto found = map.find( pos );
-
-    if( found == map.end() ) {
-        // Need new entry in map.  Make the new list entry and point to it.
-        ordered_list.emplace_back( pos, t );
-        map[pos] = std::prev( ordered_list.end() );
-        trim( limit );
-    } else {
-        // Splice existing entry to the back.  Does not invalidate the
-        // iterator, so no need to change the map.
-        auto list_iterator = found->second;
-        ordered_list.splice( ordered_list.end(), ordered_list, list_iterator );
-        // Update the moved item
-        list_iterator->second = t;
+    spare_slots.clear();
+    spare_slots.resize( capacity );
+    const size_t mask = capacity - 1;
+    for( slot &s : slots ) {
+        if( s.state != slot_state::full ) {
+            continue;
+        }
+        size_t i = std::hash<Key>()( s.key ) & mask;
+        while( spare_slots[i].state != slot_state::empty ) {
+            i = ( i + 1 ) & mask;
+        }
+        spare_slots[i] = std::move( s );
     }
+    std::swap( slots, spare_slots );
+    spare_slots.clear();
+    deleted = 0;
+    clock_hand = 0;
 }
 
 template<typename Key, typename Value>
-void lru_cache<Key, Value>::trim( int limit )
+void lru_cache<Key, Value>::reserve_one()
 {
-    while( map.size() > static_cast<size_t>( limit ) ) {
-        map.erase( ordered_list.front().first );
-        ordered_list.pop_front();
+    if( !slots.empty() && ( used + deleted + 1 ) * 4 <= slots.size() * 3 ) {
+        return;
+    }
+    // Either grow, or just get rid of deleted slots if the live entries still fit
+    size_t capacity = std::max( min_capacity, slots.size() );
+    while( ( used + 1 ) * 2 > capacity ) {
+        capacity *= 2;
     }
+    rehash( capacity );
+}
+
+template<typename Key, typename Value>
+void lru_cache<Key, Value>::insert( int limit, const Key &pos, const Value &t )
+{
+    if( limit <= 0 ) {
+        clear();
+        return;
+    }
+
+    const size_t found = find( pos );
+    if( found != slots.size() ) {
+        slots[found].value = t;
+        slots[found].referenced = true;
+        return;
+    }
+
+    while( used >= static_cast<size_t>( limit ) ) {
+        evict_one();
+    }
+    reserve_one();
+
+    const size_t mask = slots.size() - 1;
+    size_t i = std::hash<Key>()( pos ) & mask;
+    while( slots[i].state == slot_state::full ) {
+        i = ( i + 1 ) & mask;
+    }
+    slot &s = slots[i];
+    if( s.state == slot_state::deleted ) {
+        deleted--;
+    }
+    s.key = pos;
+    s.value = t;
+    s.state = slot_state::full;
+    s.referenced = true;
+    used++;
 }
 
 template<typename Key, typename Value>
 void lru_cache<Key, Value>::clear()
 {
-    map.clear();
-    ordered_list.clear();
+    if( used == 0 && deleted == 0 ) {
+        return;
+    }
+    // Keep the table itself, it is going to be refilled
+    for( slot &s : slots ) {
+        if( s.state == slot_state::full ) {
+            s.key = Key();
+            s.value = Value();
+        }
+        s.state = slot_state::empty;
+        s.referenced = false;
+    }
+    used = 0;
+    deleted = 0;
+    clock_hand = 0;
+}
+
+template<typename Key, typename Value>
+size_t lru_cache<Key, Value>::size() const
+{
+    return used;
+}
+
+template<typename Key, typename Value>
+const typename lru_cache<Key, Value>::cache_stats &lru_cache<Key, Value>::stats() const
+{
+    return counters;
 }
 
 template<typename Key, typename Value>
-const std::list<typename lru_cache<Key, Value>::Pair> &lru_cache<Key, Value>::list() const
+void lru_cache<Key, Value>::reset_stats()
 {
-    return ordered_list;
+    counters = cache_stats();
 }
 
 // explicit template initialization for lru_cache of all types
 template class lru_cache<tripoint, int>;
 template class lru_cache<point, char>;
-template class lru_cache<std::string, shared_ptr_fast<std::istringstream>>;
+template class lru_cache<std::string, shared_ptr_fast<const mapped_file>>;
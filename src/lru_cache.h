@@ -1,27 +1,70 @@
 #pragma once
 
-#include <list>
-#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
 #include <utility>
+#include <vector>
 
 #include "enums.h" // IWYU pragma: keep
 
+/**
+ * Bounded key-value cache that evicts entries that were not recently used.
+ *
+ * Entries live in a single open-addressed table (linear probing), so inserting
+ * and evicting don't allocate once the table has grown to fit `limit` entries.
+ * Eviction uses the CLOCK approximation of LRU: inserting or reading an entry
+ * marks it as referenced, and the clock hand sweeps the table clearing marks
+ * until it finds an unreferenced entry to evict.
+ */
 template<typename Key, typename Value>
 class lru_cache
 {
     public:
-        using Pair = std::pair<Key, Value>;
+        struct cache_stats {
+            int64_t hits = 0;
+            int64_t misses = 0;
+            int64_t evictions = 0;
+        };
 
         void insert( int limit, const Key &, const Value & );
         Value get( const Key &, const Value &default_ ) const;
         void remove( const Key & );
 
         void clear();
-        const std::list<Pair> &list() const;
+        size_t size() const;
+
+        /** Hit, miss and eviction counts of this instance since construction or @ref reset_stats. */
+        const cache_stats &stats() const;
+        void reset_stats();
     private:
-        void trim( int limit );
-        std::list<Pair> ordered_list;
-        std::unordered_map<Key, typename std::list<Pair>::iterator> map;
+        enum class slot_state : uint8_t {
+            empty,
+            full,
+            deleted,
+        };
+
+        struct slot {
+            Key key;
+            Value value;
+            slot_state state = slot_state::empty;
+            mutable bool referenced = false;
+        };
+
+        // Index of the slot holding the key, or slots.size() if absent
+        size_t find( const Key & ) const;
+        void erase_slot( slot & );
+        void evict_one();
+        // Makes room for one more entry, rehashing when the table is too full
+        void reserve_one();
+        void rehash( size_t capacity );
+
+        std::vector<slot> slots;
+        // Reused by rehash so the table can be rebuilt without allocating
+        std::vector<slot> spare_slots;
+        size_t used = 0;
+        size_t deleted = 0;
+        size_t clock_hand = 0;
+        mutable cache_stats counters;
 };
 
 
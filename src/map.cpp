@@ -6,10 +6,12 @@
 #include <climits>
 #include <cstdlib>
 #include <cstring>
+#include <future>
 #include <limits>
 #include <optional>
 #include <ostream>
 #include <queue>
+#include <thread>
 #include <type_traits>
 #include <unordered_map>
 
@@ -19,6 +21,7 @@
 #include "artifact.h"
 #include "avatar.h"
 #include "bodypart.h"
+#include "cached_options.h"
 #include "calendar.h"
 #include "cata_utility.h"
 #include "character.h"
@@ -46,6 +49,7 @@
 #include "fungal_effects.h"
 #include "game.h"
 #include "harvest.h"
+#include "hierarchical_pathfinding.h"
 #include "iexamine.h"
 #include "input.h"
 #include "int_id.h"
@@ -75,6 +79,7 @@
 #include "output.h"
 #include "overmapbuffer.h"
 #include "legacy_pathfinding.h"
+#include "pathfinding.h"
 #include "player.h"
 #include "point_float.h"
 #include "projectile.h"
@@ -204,10 +209,13 @@ map::map( int mapsize, bool zlev )
 map::~map() = default;
 map &map::operator=( map && )  noexcept = default;
 
+thread_local bool map::skip_vision_cache = false;
+
 void map::set_transparency_cache_dirty( const int zlev )
 {
     if( inbounds_z( zlev ) ) {
         get_cache( zlev ).transparency_cache_dirty.set();
+        Creature::invalidate_sight_cache( zlev );
     }
 }
 
@@ -221,10 +229,18 @@ void map::set_seen_cache_dirty( const tripoint change_location )
         if( cache.seen_cache[change_location.x][change_location.y] != 0.0 ||
             cache.camera_cache[change_location.x][change_location.y] != 0.0 ) {
             cache.seen_cache_dirty = true;
+            Creature::invalidate_sight_cache( change_location );
         }
     }
 }
 
+void map::set_lightmap_dirty( const int zlev )
+{
+    if( inbounds_z( zlev ) ) {
+        get_cache( zlev ).static_light_valid = false;
+    }
+}
+
 void map::set_outside_cache_dirty( const int zlev )
 {
     if( inbounds_z( zlev ) ) {
@@ -239,6 +255,13 @@ void map::set_suspension_cache_dirty( const int zlev )
     }
 }
 
+void map::set_scent_cache_dirty( const int zlev )
+{
+    if( inbounds_z( zlev ) ) {
+        get_cache( zlev ).scent_transfer_cache_dirty = true;
+    }
+}
+
 void map::set_floor_cache_dirty( const int zlev )
 {
     if( inbounds_z( zlev ) ) {
@@ -251,6 +274,7 @@ void map::set_seen_cache_dirty( const int zlevel )
     if( inbounds_z( zlevel ) ) {
         level_cache &cache = get_cache( zlevel );
         cache.seen_cache_dirty = true;
+        Creature::invalidate_sight_cache( zlevel );
     }
 }
 
@@ -259,6 +283,7 @@ void map::set_transparency_cache_dirty( const tripoint &p )
     if( inbounds( p ) ) {
         const tripoint smp = ms_to_sm_copy( p );
         get_cache( smp.z ).transparency_cache_dirty.set( smp.x * MAPSIZE + smp.y );
+        Creature::invalidate_sight_cache( p );
     }
 }
 
@@ -478,6 +503,10 @@ void map::on_vehicle_moved( const int smz )
     set_floor_cache_dirty( smz );
     set_floor_cache_dirty( smz + 1 );
     set_pathfinding_cache_dirty( smz );
+    if( g != nullptr && this == &get_map() ) {
+        Pathfinding::mark_dirty_z_level( smz );
+        HierarchicalPathfinding::mark_dirty_z_level( smz );
+    }
 }
 
 void map::vehmove()
@@ -1505,6 +1534,11 @@ void map::furn_set( const tripoint &p, const furn_id &new_furniture,
         set_outside_cache_dirty( p.z );
     }
 
+    if( old_t.has_flag( TFLAG_NO_SCENT ) != new_t.has_flag( TFLAG_NO_SCENT ) ||
+        old_t.has_flag( TFLAG_REDUCE_SCENT ) != new_t.has_flag( TFLAG_REDUCE_SCENT ) ) {
+        set_scent_cache_dirty( p.z );
+    }
+
     if( old_t.has_flag( TFLAG_NO_FLOOR ) != new_t.has_flag( TFLAG_NO_FLOOR ) ) {
         set_floor_cache_dirty( p.z );
         set_seen_cache_dirty( p );
@@ -1520,6 +1554,10 @@ void map::furn_set( const tripoint &p, const furn_id &new_furniture,
 
     // TODO: Limit to changes that affect move cost, traps and stairs
     set_pathfinding_cache_dirty( p.z );
+    if( g != nullptr && this == &get_map() ) {
+        Pathfinding::mark_dirty_tile( p );
+        HierarchicalPathfinding::mark_dirty_tile( p );
+    }
 
     // Make sure the furniture falls if it needs to
     support_dirty( p );
@@ -1530,7 +1568,7 @@ void map::furn_set( const tripoint &p, const furn_id &new_furniture,
     if( old_t.active ) {
         current_submap->active_furniture.erase( point_sm_ms( l ) );
         // TODO: Only for g->m? Observer pattern?
-        get_distribution_grid_tracker().on_changed( tripoint_abs_ms( getabs( p ) ) );
+        get_distribution_grid_tracker().on_furniture_changed( tripoint_abs_ms( getabs( p ) ) );
     }
     if( new_t.active || new_active ) {
         cata::poly_serialized<active_tile_data> atd;
@@ -1541,7 +1579,7 @@ void map::furn_set( const tripoint &p, const furn_id &new_furniture,
             atd->set_last_updated( calendar::turn );
         }
         current_submap->active_furniture[point_sm_ms( l )] = atd;
-        get_distribution_grid_tracker().on_changed( tripoint_abs_ms( getabs( p ) ) );
+        get_distribution_grid_tracker().on_furniture_changed( tripoint_abs_ms( getabs( p ) ) );
     }
 }
 
@@ -1835,6 +1873,11 @@ bool map::ter_set( const tripoint &p, const ter_id &new_terrain )
         set_outside_cache_dirty( p.z );
     }
 
+    if( old_t.has_flag( TFLAG_NO_SCENT ) != new_t.has_flag( TFLAG_NO_SCENT ) ||
+        old_t.has_flag( TFLAG_REDUCE_SCENT ) != new_t.has_flag( TFLAG_REDUCE_SCENT ) ) {
+        set_scent_cache_dirty( p.z );
+    }
+
     if( new_t.has_flag( TFLAG_NO_FLOOR ) != old_t.has_flag( TFLAG_NO_FLOOR ) ) {
         set_floor_cache_dirty( p.z );
         // It's a set, not a flag
@@ -1855,6 +1898,10 @@ bool map::ter_set( const tripoint &p, const ter_id &new_terrain )
 
     // TODO: Limit to changes that affect move cost, traps and stairs
     set_pathfinding_cache_dirty( p.z );
+    if( g != nullptr && this == &get_map() ) {
+        Pathfinding::mark_dirty_tile( p );
+        HierarchicalPathfinding::mark_dirty_tile( p );
+    }
 
     tripoint above( p.xy(), p.z + 1 );
     // Make sure that if we supported something and no longer do so, it falls down
@@ -5732,6 +5779,7 @@ bool map::add_field( const tripoint &p, const field_type_id &type_id, int intens
     invalidate_max_populated_zlev( p.z );
 
     if( current_submap->get_field( l ).add_field( type_id, intensity, age ) ) {
+        current_submap->add_active_field( l, type_id );
         //Only adding it to the count if it doesn't exist.
         if( !current_submap->field_count++ ) {
             get_cache( p.z ).field_cache.set( static_cast<size_t>( p.x / SEEX + ( (
@@ -5775,6 +5823,7 @@ void map::remove_field( const tripoint &p, const field_type_id &field_to_remove
     submap *const current_submap = get_submap_at( p, l );
 
     if( current_submap->get_field( l ).remove_field( field_to_remove ) ) {
+        current_submap->remove_active_field( l, field_to_remove );
         // Only adjust the count if the field actually existed.
         if( !--current_submap->field_count ) {
             get_cache( p.z ).field_cache.set( static_cast<size_t>( p.x / SEEX + ( (
@@ -6433,7 +6482,7 @@ bool map::sees( const tripoint &F, const tripoint &T, const int range,
         min.x << 16 | min.y << 8 | ( min.z + OVERMAP_DEPTH ),
         max.x << 16 | max.y << 8 | ( max.z + OVERMAP_DEPTH )
     );
-    char cached = skew_vision_cache.get( key, -1 );
+    char cached = skip_vision_cache ? -1 : skew_vision_cache.get( key, -1 );
     if( cached >= 0 ) {
         return cached > 0;
     }
@@ -6458,7 +6507,9 @@ bool map::sees( const tripoint &F, const tripoint &T, const int range,
             last_point = new_point;
             return true;
         } );
-        skew_vision_cache.insert( 100000, key, visible ? 1 : 0 );
+        if( !skip_vision_cache ) {
+            skew_vision_cache.insert( 100000, key, visible ? 1 : 0 );
+        }
         return visible;
     }
 
@@ -6491,7 +6542,9 @@ bool map::sees( const tripoint &F, const tripoint &T, const int range,
         last_point = new_point;
         return true;
     } );
-    skew_vision_cache.insert( 100000, key, visible ? 1 : 0 );
+    if( !skip_vision_cache ) {
+        skew_vision_cache.insert( 100000, key, visible ? 1 : 0 );
+    }
     return visible;
 }
 
@@ -6896,6 +6949,10 @@ void map::load( const tripoint &w, const bool update_vehicle, const bool pump_ev
     field_furn_locs.clear();
     submaps_with_active_items.clear();
     set_abs_sub( w );
+    if( g != nullptr && this == &get_map() ) {
+        Pathfinding::clear_d_maps();
+        HierarchicalPathfinding::clear();
+    }
     for( int gridx = 0; gridx < my_MAPSIZE; gridx++ ) {
         for( int gridy = 0; gridy < my_MAPSIZE; gridy++ ) {
             loadn( point( gridx, gridy ), update_vehicle );
@@ -7068,6 +7125,10 @@ void map::shift( point sp )
 
     g->shift_destination_preview( point( -sp.x * SEEX, -sp.y * SEEY ) );
 
+    // Pathfinding caches are in local coordinates
+    Pathfinding::clear_d_maps();
+    HierarchicalPathfinding::shift( sp );
+
     shift_traps( tripoint( sp, 0 ) );
 
     vehicle *remoteveh = g->remoteveh();
@@ -7090,6 +7151,7 @@ void map::shift( point sp )
     // absx and absy are our position in the world, for saving/loading purposes.
     for( int gridz = zmin; gridz <= zmax; gridz++ ) {
         clear_vehicle_list( gridz );
+        set_lightmap_dirty( gridz );
         shift_bitset_cache<MAPSIZE_X, SEEX>( get_cache( gridz ).map_memory_seen_cache, sp );
         shift_bitset_cache<MAPSIZE, 1>( get_cache( gridz ).field_cache, sp );
         if( sp.x >= 0 ) {
@@ -7186,6 +7248,49 @@ void map::shift( point sp )
     if( !support_cache_dirty.empty() ) {
         shift_tripoint_set( support_cache_dirty, shift_offset_pt, boundaries_2d );
     }
+
+    // Other maps (mapgen, tinymaps) are short-lived and don't follow the player
+    if( this == &get_map() ) {
+        prefetch_ahead( sp );
+    }
+}
+
+void map::prefetch_ahead( point sp )
+{
+    // A vehicle moves about velocity / 400 tiles per turn, look ahead as many submaps
+    // as it can cross in a turn.
+    int distance = 1;
+    if( g->u.controlling_vehicle ) {
+        if( const vehicle *veh = veh_pointer_or_null( veh_at( g->u.pos() ) ) ) {
+            distance = clamp( 1 + std::abs( veh->velocity ) / ( 400 * SEEX ), 1, 3 );
+        }
+    }
+
+    const tripoint abs = get_abs_sub();
+    const int zmin = zlevels ? -OVERMAP_DEPTH : abs.z;
+    const int zmax = zlevels ? OVERMAP_HEIGHT : abs.z;
+    // Submaps beyond the edges we're moving towards, including the corner between them.
+    const int xmin = sp.x > 0 ? abs.x + my_MAPSIZE : sp.x < 0 ? abs.x - distance : abs.x;
+    const int xmax = sp.x > 0 ? abs.x + my_MAPSIZE - 1 + distance : sp.x < 0 ? abs.x - 1 :
+                     abs.x + my_MAPSIZE - 1;
+    const int ymin = sp.y > 0 ? abs.y + my_MAPSIZE : sp.y < 0 ? abs.y - distance : abs.y;
+    const int ymax = sp.y > 0 ? abs.y + my_MAPSIZE - 1 + distance : sp.y < 0 ? abs.y - 1 :
+                     abs.y + my_MAPSIZE - 1;
+    const auto prefetch_rect = [&]( int x0, int x1, int y0, int y1 ) {
+        for( int gridz = zmin; gridz <= zmax; gridz++ ) {
+            for( int x = x0; x <= x1; x++ ) {
+                for( int y = y0; y <= y1; y++ ) {
+                    MAPBUFFER.prefetch_submap( tripoint( x, y, gridz ) );
+                }
+            }
+        }
+    };
+    if( sp.x != 0 ) {
+        prefetch_rect( xmin, xmax, std::min( ymin, abs.y ), std::max( ymax, abs.y + my_MAPSIZE - 1 ) );
+    }
+    if( sp.y != 0 ) {
+        prefetch_rect( std::min( xmin, abs.x ), std::max( xmax, abs.x + my_MAPSIZE - 1 ), ymin, ymax );
+    }
 }
 
 void map::vertical_shift( const int newz )
@@ -7319,6 +7424,7 @@ void map::loadn( const tripoint &grid, const bool update_vehicles )
     set_transparency_cache_dirty( grid.z );
     set_seen_cache_dirty( grid.z );
     set_outside_cache_dirty( grid.z );
+    set_scent_cache_dirty( grid.z );
     set_floor_cache_dirty( grid.z );
     set_pathfinding_cache_dirty( grid.z );
     set_suspension_cache_dirty( grid.z );
@@ -8592,25 +8698,75 @@ void map::do_vehicle_caching( int z )
     }
 }
 
+static void reset_vehicle_diagonal_caches( level_cache &ch )
+{
+    diagonal_blocks fill = {false, false};
+    std::uninitialized_fill_n( &( ch.vehicle_obscured_cache[0][0] ), MAPSIZE_X * MAPSIZE_Y, fill );
+    std::uninitialized_fill_n( &( ch.vehicle_obstructed_cache[0][0] ), MAPSIZE_X * MAPSIZE_Y, fill );
+}
+
+void map::build_level_caches_parallel( const int minz, const int maxz,
+                                       std::array<bool, OVERMAP_LAYERS> &floor_rebuilt )
+{
+    ZoneScoped;
+    // Shared between all levels, so it has to be updated before any worker reads it
+    update_weather_transparency_lookup();
+
+    const int num_levels = maxz - minz + 1;
+    const int num_workers = std::min<int>( num_levels,
+                                           std::max( 1u, std::thread::hardware_concurrency() ) );
+    // Each worker only touches the level_cache of the levels assigned to it,
+    // submaps and terrain data are only read.
+    const auto build_levels = [&]( const int first ) {
+        for( int z = minz + first; z <= maxz; z += num_workers ) {
+            build_outside_cache( z );
+            build_transparency_cache( z );
+            floor_rebuilt[z + OVERMAP_DEPTH] = build_floor_cache( z );
+            reset_vehicle_diagonal_caches( get_cache( z ) );
+        }
+    };
+
+    std::vector<std::future<void>> tasks;
+    tasks.reserve( num_workers - 1 );
+    for( int i = 1; i < num_workers; i++ ) {
+        tasks.push_back( std::async( std::launch::async, build_levels, i ) );
+    }
+    build_levels( 0 );
+    for( auto &task : tasks ) {
+        task.get();
+    }
+}
+
 void map::build_map_cache( const int zlev, bool skip_lightmap )
 {
     ZoneScoped;
     const int minz = zlevels ? -OVERMAP_DEPTH : zlev;
     const int maxz = zlevels ? OVERMAP_HEIGHT : zlev;
     bool seen_cache_dirty = false;
+    std::array<bool, OVERMAP_LAYERS> floor_rebuilt = {};
+    const bool parallel = parallel_map_cache && minz < maxz;
+    if( parallel ) {
+        build_level_caches_parallel( minz, maxz, floor_rebuilt );
+    }
     for( int z = minz; z <= maxz; z++ ) {
         // trigger FOV recalculation only when there is a change on the player's level or if fov_3d is enabled
         const bool affects_seen_cache =  z == zlev || fov_3d;
-        build_outside_cache( z );
-        build_transparency_cache( z );
+        if( !parallel ) {
+            build_outside_cache( z );
+            build_transparency_cache( z );
+        }
         update_suspension_cache( z );
-        seen_cache_dirty |= ( build_floor_cache( z ) && affects_seen_cache );
+        if( !parallel ) {
+            floor_rebuilt[z + OVERMAP_DEPTH] = build_floor_cache( z );
+        }
+        if( floor_rebuilt[z + OVERMAP_DEPTH] ) {
+            Creature::invalidate_sight_cache( z );
+        }
+        seen_cache_dirty |= floor_rebuilt[z + OVERMAP_DEPTH] && affects_seen_cache;
         seen_cache_dirty |= get_cache( z ).seen_cache_dirty && affects_seen_cache;
-        diagonal_blocks fill = {false, false};
-        std::uninitialized_fill_n( &( get_cache( z ).vehicle_obscured_cache[0][0] ), MAPSIZE_X * MAPSIZE_Y,
-                                   fill );
-        std::uninitialized_fill_n( &( get_cache( z ).vehicle_obstructed_cache[0][0] ),
-                                   MAPSIZE_X * MAPSIZE_Y, fill );
+        if( !parallel ) {
+            reset_vehicle_diagonal_caches( get_cache( z ) );
+        }
     }
     // needs a separate pass as it changes the caches on neighbour z-levels (e.g. floor_cache);
     // otherwise such changes might be overwritten by main cache-building logic
@@ -8618,8 +8774,12 @@ void map::build_map_cache( const int zlev, bool skip_lightmap )
         do_vehicle_caching( z );
     }
 
-    seen_cache_dirty |= build_vision_transparency_cache( get_player_character() );
+    if( build_vision_transparency_cache( get_player_character() ) ) {
+        seen_cache_dirty = true;
+        Creature::invalidate_sight_cache( zlev );
+    }
 
+    // Changes that made it dirty have already invalidated the affected creature sight checks
     if( seen_cache_dirty ) {
         skew_vision_cache.clear();
     }
@@ -8748,6 +8908,7 @@ void map::draw_fill_background( const ter_id &type )
     set_transparency_cache_dirty( abs_sub.z );
     set_seen_cache_dirty( abs_sub.z );
     set_outside_cache_dirty( abs_sub.z );
+    set_scent_cache_dirty( abs_sub.z );
     set_pathfinding_cache_dirty( abs_sub.z );
 
     // Fill each submap rather than each tile
@@ -8936,24 +9097,37 @@ void map::function_over( const tripoint &start, const tripoint &end, Functor fun
 void map::scent_blockers( std::array<std::array<char, MAPSIZE_X>, MAPSIZE_Y> &scent_transfer,
                           point min, point max )
 {
-    auto reduce = TFLAG_REDUCE_SCENT;
-    auto block = TFLAG_NO_SCENT;
-    auto fill_values = [&]( const tripoint & gp, const submap * sm, point  lp ) {
-        // We need to generate the x/y coordinates, because we can't get them "for free"
-        const point p = lp + sm_to_ms_copy( gp.xy() );
-        if( sm->get_ter( lp ).obj().has_flag( block ) ) {
-            scent_transfer[p.x][p.y] = 0;
-        } else if( sm->get_ter( lp ).obj().has_flag( reduce ) ||
-                   sm->get_furn( lp ).obj().has_flag( reduce ) ) {
-            scent_transfer[p.x][p.y] = 1;
-        } else {
-            scent_transfer[p.x][p.y] = 5;
-        }
+    level_cache &ch = get_cache( abs_sub.z );
+    if( ch.scent_transfer_cache_dirty ) {
+        auto reduce = TFLAG_REDUCE_SCENT;
+        auto block = TFLAG_NO_SCENT;
+        auto fill_values = [&]( const tripoint & gp, const submap * sm, point  lp ) {
+            // We need to generate the x/y coordinates, because we can't get them "for free"
+            const point p = lp + sm_to_ms_copy( gp.xy() );
+            if( sm->get_ter( lp ).obj().has_flag( block ) ) {
+                ch.scent_transfer_cache[p.x][p.y] = 0;
+            } else if( sm->get_ter( lp ).obj().has_flag( reduce ) ||
+                       sm->get_furn( lp ).obj().has_flag( reduce ) ) {
+                ch.scent_transfer_cache[p.x][p.y] = 1;
+            } else {
+                ch.scent_transfer_cache[p.x][p.y] = 5;
+            }
 
-        return ITER_CONTINUE;
-    };
+            return ITER_CONTINUE;
+        };
+
+        function_over( tripoint( 0, 0, abs_sub.z ),
+                       tripoint( SEEX * my_MAPSIZE - 1, SEEY * my_MAPSIZE - 1, abs_sub.z ), fill_values );
+        ch.scent_transfer_cache_dirty = false;
+    }
 
-    function_over( tripoint( min, abs_sub.z ), tripoint( max, abs_sub.z ), fill_values );
+    const point copy_min( std::max( min.x, 0 ), std::max( min.y, 0 ) );
+    const point copy_max( std::min( max.x, SEEX * my_MAPSIZE - 1 ),
+                          std::min( max.y, SEEY * my_MAPSIZE - 1 ) );
+    for( int x = copy_min.x; x <= copy_max.x; x++ ) {
+        std::copy_n( &ch.scent_transfer_cache[x][copy_min.y], copy_max.y - copy_min.y + 1,
+                     &scent_transfer[x][copy_min.y] );
+    }
 
     const inclusive_rectangle<point> local_bounds( min, max );
 
@@ -9170,12 +9344,18 @@ level_cache::level_cache()
     std::fill_n( &lm[0][0], map_dimensions, four_zeros );
     std::fill_n( &sm[0][0], map_dimensions, 0.0f );
     std::fill_n( &light_source_buffer[0][0], map_dimensions, 0.0f );
+    std::fill_n( &static_lm[0][0], map_dimensions, four_zeros );
+    std::fill_n( &static_sm[0][0], map_dimensions, 0.0f );
+    std::fill_n( &static_light_sources[0][0], map_dimensions, 0.0f );
+    std::fill_n( &static_light_transparency[0][0], map_dimensions, 0.0f );
     std::fill_n( &outside_cache[0][0], map_dimensions, false );
     std::fill_n( &floor_cache[0][0], map_dimensions, false );
     std::fill_n( &transparency_cache[0][0], map_dimensions, 0.0f );
     diagonal_blocks fill = {false, false};
     std::fill_n( &vehicle_obscured_cache[0][0], map_dimensions, fill );
     std::fill_n( &vehicle_obstructed_cache[0][0], map_dimensions, fill );
+    std::fill_n( &scent_transfer_cache[0][0], map_dimensions, 0 );
+    std::fill_n( &static_light_blocked[0][0], map_dimensions, fill );
     std::fill_n( &seen_cache[0][0], map_dimensions, 0.0f );
     std::fill_n( &camera_cache[0][0], map_dimensions, 0.0f );
     std::fill_n( &visibility_cache[0][0], map_dimensions, lit_level::DARK );
@@ -9197,6 +9377,7 @@ pathfinding_cache &map::get_pathfinding_cache( int zlev ) const
 
 void map::set_pathfinding_cache_dirty( const int zlev )
 {
+    passability_generation++;
     if( inbounds_z( zlev ) ) {
         get_pathfinding_cache( zlev ).dirty = true;
     }
@@ -9229,6 +9410,9 @@ void map::invalidate_map_cache( const int zlev )
         ch.seen_cache_dirty = true;
         ch.outside_cache_dirty = true;
         ch.suspension_cache_dirty = true;
+        ch.scent_transfer_cache_dirty = true;
+        ch.static_light_valid = false;
+        Creature::invalidate_sight_cache( zlev );
     }
 }
 
@@ -305,6 +305,7 @@ struct level_cache {
     bool seen_cache_dirty = false;
     bool suspension_cache_initialized = false;
     bool suspension_cache_dirty = false;
+    bool scent_transfer_cache_dirty = true;
     std::list<point> suspension_cache;
 
     four_quadrants lm[MAPSIZE_X][MAPSIZE_Y];
@@ -313,6 +314,18 @@ struct level_cache {
     // This is only valid for the duration of generate_lightmap
     float light_source_buffer[MAPSIZE_X][MAPSIZE_Y];
 
+    // Light cast by the bulk light sources of light_source_buffer alone.
+    // Kept between turns and only recast around sources or transparency that changed,
+    // see map::update_static_lightmap
+    four_quadrants static_lm[MAPSIZE_X][MAPSIZE_Y];
+    float static_sm[MAPSIZE_X][MAPSIZE_Y];
+    // Inputs static_lm was last built from
+    float static_light_sources[MAPSIZE_X][MAPSIZE_Y];
+    float static_light_transparency[MAPSIZE_X][MAPSIZE_Y];
+    diagonal_blocks static_light_blocked[MAPSIZE_X][MAPSIZE_Y];
+    float static_light_weather_transparency = 0.0f;
+    bool static_light_valid = false;
+
     // if false, means tile is under the roof ("inside"), true means tile is "outside"
     // "inside" tiles are protected from sun, rain, etc. (see "INDOORS" flag)
     bool outside_cache[MAPSIZE_X][MAPSIZE_Y];
@@ -334,6 +347,10 @@ struct level_cache {
     // same as above but for obstruction rather than light
     diagonal_blocks vehicle_obstructed_cache[MAPSIZE_X][MAPSIZE_Y];
 
+    // how well scent passes through terrain and furniture, see map::scent_blockers
+    // 0 for NO_SCENT, 1 for REDUCE_SCENT, 5 otherwise. Vehicles are not included.
+    char scent_transfer_cache[MAPSIZE_X][MAPSIZE_Y];
+
     // stores "visibility" of the tiles to the player
     // values range from 1 (fully visible to player) to 0 (not visible)
     float seen_cache[MAPSIZE_X][MAPSIZE_Y];
@@ -418,8 +435,19 @@ class map
         void set_floor_cache_dirty( const int zlev );
 
         void set_suspension_cache_dirty( const int zlev );
+        void set_scent_cache_dirty( const int zlev );
 
         void set_pathfinding_cache_dirty( int zlev );
+        /**
+         * Bumped by every @ref set_pathfinding_cache_dirty, so a caller that looked up
+         * passability earlier can tell whether it may have changed since.
+         */
+        int64_t get_passability_generation() const {
+            return passability_generation;
+        }
+
+        // forces the next lightmap to recast every bulk light source instead of only the changed ones
+        void set_lightmap_dirty( int zlev );
         /*@}*/
 
         void set_memory_seen_cache_dirty( const tripoint &p );
@@ -614,6 +642,11 @@ class map
         * Returns whether `F` sees `T` with a view range of `range`.
         */
         bool sees( const tripoint &F, const tripoint &T, int range ) const;
+        /**
+         * Set on threads that call @ref sees concurrently, they neither read nor fill the
+         * cache of recently checked coordinate pairs, which isn't thread safe.
+         */
+        static thread_local bool skip_vision_cache;
     private:
         /**
          * Don't expose the slope adjust outside map functions.
@@ -1493,6 +1526,8 @@ class map
         /**
          * Build the map of scent-resistant tiles.
          * Should be way faster than if done in `game.cpp` using public map functions.
+         * Terrain and furniture are cached per z-level until @ref set_scent_cache_dirty,
+         * vehicles are added on every call.
          */
         void scent_blockers( std::array<std::array<char, MAPSIZE_X>, MAPSIZE_Y> &scent_transfer,
                              point min, point max );
@@ -1721,6 +1756,11 @@ class map
                 loadn( tripoint( grid, abs_sub.z ), update_vehicles );
             }
         }
+        /**
+         * Start loading the submaps that further shifts by @p sp would bring into the map
+         * in the background. Looks further ahead when the player drives a fast vehicle.
+         */
+        void prefetch_ahead( point sp );
         /**
          * Fast forward a submap that has just been loading into this map.
          * This is used to rot and remove rotten items, grow plants, fill funnels etc.
@@ -1789,6 +1829,9 @@ class map
         // Builds a transparency cache and returns true if the cache was invalidated.
         // Used to determine if seen cache should be rebuilt.
         bool build_transparency_cache( int zlev );
+        // Refreshes the shared weather transparency lookup used by shadowcasting fast paths.
+        // Must be called on the main thread before transparency caches are built in parallel.
+        void update_weather_transparency_lookup();
         bool build_vision_transparency_cache( const Character &player );
         // fills lm with sunlight. pzlev is current player's zlevel
         void build_sunlight_cache( int pzlev );
@@ -1802,7 +1845,21 @@ class map
         // Checks all suspended tiles on a z level and adds those that are invalid to the support_dirty_cache */
         void update_suspension_cache( const int &z );
     protected:
+        /**
+         * Builds the caches of every z-level in [minz, maxz] that only depend on their own level
+         * (outside, transparency and floor caches), spreading the levels over worker threads.
+         * Writes whether each floor cache was rebuilt into @p floor_rebuilt, indexed by z + OVERMAP_DEPTH.
+         * Caches that depend on other levels (sunlight, seen cache, vehicles) must be built afterwards.
+         */
+        void build_level_caches_parallel( int minz, int maxz,
+                                          std::array<bool, OVERMAP_LAYERS> &floor_rebuilt );
         void generate_lightmap( int zlev );
+        /**
+         * Brings level_cache::static_lm up to date with the bulk light sources in light_source_buffer.
+         * Only sources whose luminance or neighbours changed, or whose reach covers a tile with changed
+         * transparency, are recast together with everything that overlaps them.
+         */
+        void update_static_lightmap( int zlev );
         void build_seen_cache( const tripoint &origin, int target_z );
         void apply_character_light( Character &p );
 
@@ -1990,6 +2047,7 @@ class map
         std::array< std::unique_ptr<level_cache>, OVERMAP_LAYERS > caches;
 
         mutable std::array< std::unique_ptr<pathfinding_cache>, OVERMAP_LAYERS > pathfinding_caches;
+        int64_t passability_generation = 0;
         /**
          * Set of submaps that contain active items in absolute coordinates.
          */
@@ -255,16 +255,6 @@ void map::gas_spread_to( field_entry &cur, maptile &dst, const tripoint &p )
 void map::spread_gas( field_entry &cur, const tripoint &p, int percent_spread,
                       const time_duration &outdoor_age_speedup, scent_block &sblk )
 {
-    map &here = get_map();
-    // TODO: fix point types
-    const oter_id &cur_om_ter =
-        overmap_buffer.ter( tripoint_abs_omt( ms_to_omt_copy( here.getabs( p ) ) ) );
-    const bool sheltered = g->is_sheltered( p );
-    const weather_manager &weather = get_weather();
-    const int winddirection = weather.winddirection;
-    const int windpower = get_local_windpower( weather.windspeed, cur_om_ter, p, winddirection,
-                          sheltered );
-
     const int current_intensity = cur.get_field_intensity();
     const field_type_id ft_id = cur.get_field_type();
 
@@ -284,8 +274,24 @@ void map::spread_gas( field_entry &cur, const tripoint &p, int percent_spread,
         cur.set_field_age( current_age + outdoor_age_speedup );
     }
 
-    // Bail out if we don't meet the spread chance or required intensity.
-    if( current_intensity <= 1 || rng( 1, 100 - windpower ) > percent_spread ) {
+    // Bail out if we don't meet the required intensity.
+    // Most of a gas cloud is thin, so check it before the (comparatively slow) wind lookups.
+    if( current_intensity <= 1 ) {
+        return;
+    }
+
+    map &here = get_map();
+    // TODO: fix point types
+    const oter_id &cur_om_ter =
+        overmap_buffer.ter( tripoint_abs_omt( ms_to_omt_copy( here.getabs( p ) ) ) );
+    const bool sheltered = g->is_sheltered( p );
+    const weather_manager &weather = get_weather();
+    const int winddirection = weather.winddirection;
+    const int windpower = get_local_windpower( weather.windspeed, cur_om_ter, p, winddirection,
+                          sheltered );
+
+    // Bail out if we don't meet the spread chance.
+    if( rng( 1, 100 - windpower ) > percent_spread ) {
         return;
     }
 
@@ -316,17 +322,17 @@ void map::spread_gas( field_entry &cur, const tripoint &p, int percent_spread,
             spread.push_back( i );
         }
     }
-    auto maptiles = get_wind_blockers( winddirection, p );
-    // Three map tiles that are facing the wind direction.
-    const maptile remove_tile = std::get<0>( maptiles );
-    const maptile remove_tile2 = std::get<1>( maptiles );
-    const maptile remove_tile3 = std::get<2>( maptiles );
     if( !spread.empty() && ( !zlevels || one_in( spread.size() ) ) ) {
         // Construct the destination from offset and p
-        if( g->is_sheltered( p ) || windpower < 5 ) {
+        if( sheltered || windpower < 5 ) {
             std::pair<tripoint, maptile> &n = neighs[ random_entry( spread ) ];
             gas_spread_to( cur, n.second, n.first );
         } else {
+            auto maptiles = get_wind_blockers( winddirection, p );
+            // Three map tiles that are facing the wind direction.
+            const maptile remove_tile = std::get<0>( maptiles );
+            const maptile remove_tile2 = std::get<1>( maptiles );
+            const maptile remove_tile3 = std::get<2>( maptiles );
             end_it = static_cast<size_t>( rng( 0, neighs.size() - 1 ) );
             // Start at end_it + 1, then wrap around until all elements have been processed.
             for( size_t i = ( end_it + 1 ) % neighs.size(), count = 0;
@@ -416,9 +422,27 @@ void map::process_fields_in_submap( submap *const current_submap,
     int &locy = map_tile.pos_.y;
     const point sm_offset( submap.x * SEEX, submap.y * SEEY );
 
+    // Only the tiles listed with fields are looked at, but still in the order of a walk over
+    // the whole submap, and fields spreading further along this walk are picked up on the way
+    current_submap->prune_active_fields();
+    std::bitset<SEEX *SEEY> field_tiles;
+    const auto list_field_tiles = [current_submap, &field_tiles]() {
+        for( const std::pair<point, field_type_id> &entry : current_submap->active_fields ) {
+            field_tiles.set( entry.first.x * SEEY + entry.first.y );
+        }
+        return current_submap->active_fields_added;
+    };
+    int fields_added = list_field_tiles();
+
     // Loop through all tiles in this submap indicated by current_submap
     for( locx = 0; locx < SEEX; locx++ ) {
         for( locy = 0; locy < SEEY; locy++ ) {
+            if( current_submap->active_fields_added != fields_added ) {
+                fields_added = list_field_tiles();
+            }
+            if( !field_tiles[locx * SEEY + locy] ) {
+                continue;
+            }
             // Get a reference to the field variable from the submap;
             // contains all the pointers to the real field effects.
             field &curfield = current_submap->get_field( { locx, locy } );
@@ -1562,6 +1586,12 @@ void map::creature_in_field( Creature &critter )
 {
     ZoneScoped;
 
+    // Monsters are only affected by the fields on their tile. `field_cache` tells cheaply that
+    // there are none, which is the usual case, before looking for vehicles and fields.
+    if( critter.is_monster() && !has_field_at( critter.pos() ) ) {
+        return;
+    }
+
     bool in_vehicle = false;
     bool inside_vehicle = false;
     player *u = critter.as_player();
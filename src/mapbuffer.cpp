@@ -3,12 +3,15 @@
 #include <algorithm>
 #include <exception>
 #include <functional>
+#include <limits>
 #include <set>
 #include <sstream>
+#include <stdexcept>
 #include <utility>
 #include <vector>
 
 #include "cata_utility.h"
+#include "compress.h"
 #include "coordinate_conversions.h"
 #include "debug.h"
 #include "distribution_grid.h"
@@ -18,12 +21,15 @@
 #include "game_constants.h"
 #include "json.h"
 #include "map.h"
+#include "memory_istream.h"
+#include "options.h"
 #include "output.h"
 #include "popup.h"
 #include "string_formatter.h"
 #include "submap.h"
 #include "translations.h"
 #include "ui_manager.h"
+#include "vehicle.h"
 #include "world.h"
 
 mapbuffer MAPBUFFER;
@@ -34,17 +40,13 @@ mapbuffer::~mapbuffer() = default;
 void mapbuffer::clear()
 {
     submaps.clear();
+    drop_evicted_quads();
+    budget_retry_size = 0;
 }
 
 bool mapbuffer::add_submap( const tripoint &p, std::unique_ptr<submap> &sm )
 {
-    if( submaps.contains( p ) ) {
-        return false;
-    }
-
-    submaps[p] = std::move( sm );
-
-    return true;
+    return submaps.insert( p, sm );
 }
 
 bool mapbuffer::add_submap( const tripoint &p, submap *sm )
@@ -61,18 +63,15 @@ bool mapbuffer::add_submap( const tripoint &p, submap *sm )
 
 void mapbuffer::remove_submap( tripoint addr )
 {
-    auto m_target = submaps.find( addr );
-    if( m_target == submaps.end() ) {
+    if( !submaps.extract( addr ) ) {
         debugmsg( "Tried to remove non-existing submap %s", addr.to_string() );
-        return;
     }
-    submaps.erase( m_target );
 }
 
 submap *mapbuffer::lookup_submap( const tripoint &p )
 {
-    const auto iter = submaps.find( p );
-    if( iter == submaps.end() ) {
+    submap *sm = submaps.find( p );
+    if( sm == nullptr ) {
         try {
             return unserialize_submaps( p );
         } catch( const std::exception &err ) {
@@ -81,7 +80,17 @@ submap *mapbuffer::lookup_submap( const tripoint &p )
         return nullptr;
     }
 
-    return iter->second.get();
+    return sm;
+}
+
+void mapbuffer::prefetch_submap( const tripoint &p )
+{
+    if( submaps.contains( p ) || evicted_quads.contains( sm_to_omt_copy( p ) ) || g == nullptr ) {
+        return;
+    }
+    if( world *w = g->get_active_world() ) {
+        w->prefetch_map_quad( sm_to_omt_copy( p ) );
+    }
 }
 
 void mapbuffer::save( bool delete_after_save )
@@ -95,13 +104,21 @@ void mapbuffer::save( bool delete_after_save )
 
     static_popup popup;
 
-    // A set of already-saved submaps, in global overmap coordinates.
+    // The quads to save, in global overmap coordinates.
     std::set<tripoint> saved_submaps;
     std::list<tripoint> submaps_to_delete;
     static constexpr std::chrono::milliseconds update_interval( 500 );
     auto last_update = std::chrono::steady_clock::now();
 
-    for( auto &elem : submaps ) {
+    // Whatever the coordinates of a submap are, we're saving a 2x2 quad of submaps at a time.
+    // Submaps are generated in quads, so we know if we have one member of a quad,
+    // we have the rest of it, if that assumption is broken we have REAL problems.
+    // Collect the quads up front, the UI updates below may load submaps.
+    submaps.for_each( [&]( const tripoint & p, std::unique_ptr<submap> & ) {
+        saved_submaps.insert( sm_to_omt_copy( p ) );
+    } );
+
+    for( const tripoint &om_addr : saved_submaps ) {
         auto now = std::chrono::steady_clock::now();
         if( last_update + update_interval < now ) {
             popup.message( _( "Please wait as the map saves [%d/%d]" ),
@@ -111,16 +128,6 @@ void mapbuffer::save( bool delete_after_save )
             inp_mngr.pump_events();
             last_update = now;
         }
-        // Whatever the coordinates of the current submap are,
-        // we're saving a 2x2 quad of submaps at a time.
-        // Submaps are generated in quads, so we know if we have one member of a quad,
-        // we have the rest of it, if that assumption is broken we have REAL problems.
-        const tripoint om_addr = sm_to_omt_copy( elem.first );
-        if( saved_submaps.contains( om_addr ) ) {
-            // Already handled this one.
-            continue;
-        }
-        saved_submaps.insert( om_addr );
 
         // A segment is a chunk of 32x32 submap quads.
         // We're breaking them into subdirectories so there aren't too many files per directory.
@@ -140,26 +147,222 @@ void mapbuffer::save( bool delete_after_save )
         remove_submap( elem );
     }
 
+    // Evicted quads are only in the scratch file, they go to the save files now.
+    if( !disable_mapgen ) {
+        for( const auto &evicted : evicted_quads ) {
+            const std::string data = read_evicted_quad( evicted.second );
+            g->get_active_world()->write_map_quad( evicted.first, [&]( std::ostream & fout ) {
+                fout << data;
+            } );
+        }
+        drop_evicted_quads();
+    }
+    budget_retry_size = 0;
+
     get_distribution_grid_tracker().on_saved();
 }
 
+bool mapbuffer::can_evict_quad( const std::vector<tripoint> &submap_addrs ) const
+{
+    const map &here = get_map();
+    const tripoint map_origin = here.get_abs_sub();
+    const int map_size = here.getmapsize();
+    const distribution_grid_tracker &grid_tracker = get_distribution_grid_tracker();
+    for( const tripoint &p : submap_addrs ) {
+        const submap *sm = submaps.find( p );
+        if( sm == nullptr ) {
+            continue;
+        }
+        if( p.x >= map_origin.x && p.x < map_origin.x + map_size &&
+            p.y >= map_origin.y && p.y < map_origin.y + map_size ) {
+            return false;
+        }
+        if( grid_tracker.is_active_grid_submap( tripoint_abs_sm( p ) ) ) {
+            return false;
+        }
+        for( const auto &veh : sm->vehicles ) {
+            if( veh->is_moving() || veh->is_falling ) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+std::string mapbuffer::read_evicted_quad( const evicted_quad &quad ) const
+{
+    std::vector<std::byte> compressed( quad.size );
+    cata_ifstream fin = std::move( cata_ifstream().mode( cata_ios_mode::binary ).open( evicted_path ) );
+    if( fin.is_open() ) {
+        fin->seekg( quad.offset );
+        fin->read( reinterpret_cast<char *>( compressed.data() ),
+                   static_cast<std::streamsize>( quad.size ) );
+    }
+    if( !fin.is_open() || fin.fail() ) {
+        throw std::runtime_error( string_format( "failed to read evicted map data from %s",
+                                  evicted_path ) );
+    }
+    std::string data;
+    zlib_decompress( compressed.data(), compressed.size(), data );
+    return data;
+}
+
+void mapbuffer::drop_evicted_quads()
+{
+    evicted_quads.clear();
+    if( !evicted_path.empty() ) {
+        remove_file( evicted_path );
+        evicted_path.clear();
+    }
+    evicted_file_size = 0;
+}
+
+void mapbuffer::enforce_memory_budget()
+{
+    const int budget_mib = get_option<int>( "MAPBUFFER_MEMORY_BUDGET" );
+    if( budget_mib <= 0 ) {
+        submap::set_pool_limit( std::numeric_limits<size_t>::max() );
+    }
+    if( budget_mib <= 0 || g == nullptr || g->get_active_world() == nullptr ) {
+        return;
+    }
+    // Only the submaps themselves are counted, items and other contents come on top.
+    const size_t max_submaps = static_cast<size_t>( budget_mib ) * 1024 * 1024 / sizeof( submap );
+    // Freed submaps kept for reuse fit in what eviction leaves free under the budget,
+    // while it's exceeded there is no room for them.
+    submap::set_pool_limit( submaps.size() > max_submaps ? 0 : max_submaps / 8 );
+    if( submaps.size() <= max_submaps ) {
+        budget_retry_size = 0;
+        return;
+    }
+    // The last pass couldn't free enough, and the same quads would still be kept now.
+    if( submaps.size() < budget_retry_size ) {
+        return;
+    }
+    // Evict a bit more than needed, so it doesn't happen again right away.
+    const size_t target = max_submaps - max_submaps / 8;
+
+    std::unordered_map<tripoint, time_point> quad_touched;
+    submaps.for_each( [&]( const tripoint & p, std::unique_ptr<submap> &sm ) {
+        const tripoint om_addr = sm_to_omt_copy( p );
+        auto it = quad_touched.emplace( om_addr, sm->last_touched ).first;
+        it->second = std::max( it->second, sm->last_touched );
+    } );
+    std::vector<std::pair<time_point, tripoint>> candidates;
+    candidates.reserve( quad_touched.size() );
+    for( const auto &q : quad_touched ) {
+        candidates.emplace_back( q.second, q.first );
+    }
+    std::sort( candidates.begin(), candidates.end() );
+
+    if( evicted_path.empty() ) {
+        evicted_path = g->get_active_world()->info->folder_path() + "/maps_evicted.tmp";
+        remove_file( evicted_path );
+    }
+    cata_ofstream fout;
+    for( const auto &candidate : candidates ) {
+        if( submaps.size() <= target ) {
+            break;
+        }
+        const tripoint &om_addr = candidate.second;
+        const std::vector<tripoint> submap_addrs = quad_submap_addrs( om_addr );
+        if( !can_evict_quad( submap_addrs ) ) {
+            continue;
+        }
+        bool all_uniform = true;
+        for( const tripoint &p : submap_addrs ) {
+            const submap *sm = submaps.find( p );
+            if( sm != nullptr && !sm->is_uniform ) {
+                all_uniform = false;
+            }
+        }
+        // Uniform quads aren't saved at all, they are regenerated instead.
+        if( !all_uniform ) {
+            std::ostringstream quad_out;
+            serialize_quad( quad_out, submap_addrs );
+            std::vector<std::byte> compressed;
+            zlib_compress( quad_out.str(), compressed );
+            if( !fout.is_open() ) {
+                fout.mode( static_cast<cata_ios_mode>( static_cast<int>( cata_ios_mode::app ) |
+                                                       static_cast<int>( cata_ios_mode::binary ) ) );
+                fout.open( evicted_path );
+            }
+            if( fout.is_open() ) {
+                fout->write( reinterpret_cast<const char *>( compressed.data() ),
+                             static_cast<std::streamsize>( compressed.size() ) );
+                fout.flush();
+            }
+            if( !fout.is_open() || fout.fail() ) {
+                debugmsg( "Failed to write evicted map data to %s", evicted_path );
+                break;
+            }
+            evicted_quads[om_addr] = { evicted_file_size, compressed.size() };
+            evicted_file_size += compressed.size();
+        }
+        for( const tripoint &p : submap_addrs ) {
+            if( submaps.contains( p ) ) {
+                remove_submap( p );
+            }
+        }
+    }
+    // What's left can't be evicted yet, wait for a good number of new submaps
+    // (at least a z-level of the reality bubble) before scanning them all again.
+    if( submaps.size() > max_submaps ) {
+        budget_retry_size = submaps.size() + std::max<size_t>( max_submaps / 8, MAPSIZE * MAPSIZE );
+    }
+    // The evicted submaps went to the pool, only keep what fits
+    submap::set_pool_limit( submaps.size() > max_submaps ? 0 : max_submaps / 8 );
+}
+
+std::vector<tripoint> mapbuffer::quad_submap_addrs( const tripoint &om_addr )
+{
+    const tripoint origin = omt_to_sm_copy( om_addr );
+    return {
+        origin + point_zero,
+        origin + point_south,
+        origin + point_east,
+        origin + point_south_east,
+    };
+}
+
+void mapbuffer::serialize_quad( std::ostream &fout, const std::vector<tripoint> &submap_addrs )
+{
+    JsonOut jsout( fout );
+    jsout.start_array();
+    for( auto &submap_addr : submap_addrs ) {
+        submap *sm = submaps.find( submap_addr );
+
+        if( sm == nullptr ) {
+            continue;
+        }
+
+        jsout.start_object();
+
+        jsout.member( "version", savegame_version );
+        jsout.member( "coordinates" );
+
+        jsout.start_array();
+        jsout.write( submap_addr.x );
+        jsout.write( submap_addr.y );
+        jsout.write( submap_addr.z );
+        jsout.end_array();
+
+        sm->store( jsout );
+
+        jsout.end_object();
+    }
+
+    jsout.end_array();
+}
+
 void mapbuffer::save_quad( const tripoint &om_addr, std::list<tripoint> &submaps_to_delete,
                            bool delete_after_save )
 {
-    std::vector<point> offsets;
-    std::vector<tripoint> submap_addrs;
-    offsets.push_back( point_zero );
-    offsets.push_back( point_south );
-    offsets.push_back( point_east );
-    offsets.push_back( point_south_east );
+    const std::vector<tripoint> submap_addrs = quad_submap_addrs( om_addr );
 
     bool all_uniform = true;
-    for( auto &offsets_offset : offsets ) {
-        tripoint submap_addr = omt_to_sm_copy( om_addr );
-        submap_addr.x += offsets_offset.x;
-        submap_addr.y += offsets_offset.y;
-        submap_addrs.push_back( submap_addr );
-        submap *sm = submaps[submap_addr].get();
+    for( auto &submap_addr : submap_addrs ) {
+        submap *sm = submaps.find( submap_addr );
         if( sm != nullptr && !sm->is_uniform ) {
             all_uniform = false;
         }
@@ -169,7 +372,7 @@ void mapbuffer::save_quad( const tripoint &om_addr, std::list<tripoint> &submaps
         // Nothing to save - this quad will be regenerated faster than it would be re-read
         if( delete_after_save ) {
             for( auto &submap_addr : submap_addrs ) {
-                if( submaps.contains( submap_addr ) && submaps[submap_addr] != nullptr ) {
+                if( submaps.contains( submap_addr ) ) {
                     submaps_to_delete.push_back( submap_addr );
                 }
             }
@@ -183,41 +386,16 @@ void mapbuffer::save_quad( const tripoint &om_addr, std::list<tripoint> &submaps
     }
 
     g->get_active_world()->write_map_quad( om_addr, [&]( std::ostream & fout ) {
-        JsonOut jsout( fout );
-        jsout.start_array();
-        for( auto &submap_addr : submap_addrs ) {
-            if( !submaps.contains( submap_addr ) ) {
-                continue;
-            }
-
-            submap *sm = submaps[submap_addr].get();
-
-            if( sm == nullptr ) {
-                continue;
-            }
-
-            jsout.start_object();
-
-            jsout.member( "version", savegame_version );
-            jsout.member( "coordinates" );
-
-            jsout.start_array();
-            jsout.write( submap_addr.x );
-            jsout.write( submap_addr.y );
-            jsout.write( submap_addr.z );
-            jsout.end_array();
-
-            sm->store( jsout );
-
-            jsout.end_object();
+        serialize_quad( fout, submap_addrs );
+    } );
 
-            if( delete_after_save ) {
+    if( delete_after_save ) {
+        for( auto &submap_addr : submap_addrs ) {
+            if( submaps.contains( submap_addr ) ) {
                 submaps_to_delete.push_back( submap_addr );
             }
         }
-
-        jsout.end_array();
-    } );
+    }
 }
 
 // We're reading in way too many entities here to mess around with creating sub-objects and
@@ -228,8 +406,18 @@ submap *mapbuffer::unserialize_submaps( const tripoint &p )
     const tripoint om_addr = sm_to_omt_copy( p );
 
     using namespace std::placeholders;
-    if( !g->get_active_world()->read_map_quad( om_addr, std::bind( &mapbuffer::deserialize,
-            this, _1 ) ) ) {
+    const auto evicted = evicted_quads.find( om_addr );
+    if( evicted != evicted_quads.end() ) {
+        const std::string data = read_evicted_quad( evicted->second );
+        evicted_quads.erase( evicted );
+        if( evicted_quads.empty() ) {
+            drop_evicted_quads();
+        }
+        memory_istream stream( data );
+        JsonIn jsin( stream );
+        deserialize( jsin );
+    } else if( !g->get_active_world()->read_map_quad( om_addr, std::bind( &mapbuffer::deserialize,
+               this, _1 ) ) ) {
         // If it doesn't exist, trigger generating it.
         return nullptr;
     }
@@ -238,7 +426,7 @@ submap *mapbuffer::unserialize_submaps( const tripoint &p )
                   p.x, p.y, p.z );
         return nullptr;
     }
-    return submaps[ p ].get();
+    return submaps.find( p );
 }
 
 void mapbuffer::deserialize( JsonIn &jsin )
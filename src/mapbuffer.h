@@ -1,12 +1,17 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
 #include <list>
-#include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "coordinates.h"
 #include "point.h"
+#include "submap_index.h"
 
 class submap;
 class JsonIn;
@@ -29,6 +34,19 @@ class mapbuffer
         /** Delete all buffered submaps. **/
         void clear();
 
+        /**
+         * If the buffered submaps take more memory than the MAPBUFFER_MEMORY_BUDGET option
+         * allows, serialize the least recently touched quads and free their submaps.
+         * Serialized quads are compressed into a scratch file in the world folder until
+         * the next save, so the save files are not written to outside of saving.
+         * They are loaded back on lookup.
+         *
+         * Submaps in the main map, in active electric grids or holding moving vehicles
+         * are never evicted. After a pass that can't get back under the budget, the next
+         * one waits until more submaps have been loaded.
+         */
+        void enforce_memory_budget();
+
         /** Add a new submap to the buffer.
          *
          * @param x, y, z The absolute world position in submap coordinates.
@@ -56,16 +74,12 @@ class mapbuffer
             return lookup_submap( p.raw() );
         }
 
-    private:
-        using submap_map_t = std::map<tripoint, std::unique_ptr<submap>>;
-
-    public:
-        submap_map_t::iterator begin() {
-            return submaps.begin();
-        }
-        submap_map_t::iterator end() {
-            return submaps.end();
-        }
+        /** Start reading the submap from disk in the background, if it isn't loaded yet.
+         * A later @ref lookup_submap picks up the data read.
+         *
+         * @param p The absolute world position in submap coordinates.
+         */
+        void prefetch_submap( const tripoint &p );
 
         bool is_submap_loaded( const tripoint &p ) const {
             return submaps.contains( p );
@@ -79,7 +93,29 @@ class mapbuffer
         void deserialize( JsonIn &jsin );
         void save_quad( const tripoint &om_addr, std::list<tripoint> &submaps_to_delete,
                         bool delete_after_save );
-        submap_map_t submaps;
+        /** Submap addresses of the quad at @p om_addr */
+        static std::vector<tripoint> quad_submap_addrs( const tripoint &om_addr );
+        void serialize_quad( std::ostream &fout, const std::vector<tripoint> &submap_addrs );
+        /** Whether the quad may be serialized and freed to stay in the memory budget */
+        bool can_evict_quad( const std::vector<tripoint> &submap_addrs ) const;
+        /** Where the compressed contents of an evicted quad are in @ref evicted_path */
+        struct evicted_quad {
+            int64_t offset = 0;
+            size_t size = 0;
+        };
+        /** Decompressed contents of an evicted quad */
+        std::string read_evicted_quad( const evicted_quad &quad ) const;
+        /** Forget all evicted quads and delete the scratch file */
+        void drop_evicted_quads();
+
+        submap_index<std::unique_ptr<submap>> submaps;
+        /** Quads evicted since the last save, by overmap address */
+        std::unordered_map<tripoint, evicted_quad> evicted_quads;
+        /** Scratch file the evicted quads are appended to, empty if there is none */
+        std::string evicted_path;
+        int64_t evicted_file_size = 0;
+        /** Don't look for quads to evict again until this many submaps are loaded */
+        size_t budget_retry_size = 0;
 };
 
 extern mapbuffer MAPBUFFER;
@@ -1014,6 +1014,7 @@ void memorial_logger::notify( const cata::event &e )
         }
         // All the events for which we have no memorial log are here
         case event_type::avatar_moves:
+        case event_type::character_drops_item:
         case event_type::character_gets_headshot:
         case event_type::character_heals_damage:
         case event_type::character_takes_damage:
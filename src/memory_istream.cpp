@@ -0,0 +1,39 @@
+#include "memory_istream.h"
+
+memory_streambuf::memory_streambuf( std::string_view data )
+{
+    // The get area is never written through, std::streambuf just has no const interface.
+    char *begin = const_cast<char *>( data.data() );
+    setg( begin, begin, begin + data.size() );
+}
+
+memory_streambuf::pos_type memory_streambuf::seekoff( off_type off, std::ios_base::seekdir dir,
+        std::ios_base::openmode which )
+{
+    if( !( which & std::ios_base::in ) ) {
+        return pos_type( off_type( -1 ) );
+    }
+    off_type origin = 0;
+    if( dir == std::ios_base::cur ) {
+        origin = gptr() - eback();
+    } else if( dir == std::ios_base::end ) {
+        origin = egptr() - eback();
+    }
+    const off_type target = origin + off;
+    if( target < 0 || target > egptr() - eback() ) {
+        return pos_type( off_type( -1 ) );
+    }
+    setg( eback(), eback() + target, egptr() );
+    return pos_type( target );
+}
+
+memory_streambuf::pos_type memory_streambuf::seekpos( pos_type pos,
+        std::ios_base::openmode which )
+{
+    return seekoff( off_type( pos ), std::ios_base::beg, which );
+}
+
+memory_istream::memory_istream( std::string_view data ) : std::istream( nullptr ), buf( data )
+{
+    rdbuf( &buf );
+}
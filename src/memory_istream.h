@@ -0,0 +1,35 @@
+#pragma once
+
+#include <istream>
+#include <streambuf>
+#include <string_view>
+
+/**
+ * Read-only stream buffer over memory owned by someone else.
+ * Supports seeking, which JsonIn needs for error reporting and deferred loading.
+ */
+class memory_streambuf : public std::streambuf
+{
+    public:
+        explicit memory_streambuf( std::string_view data );
+
+    protected:
+        pos_type seekoff( off_type off, std::ios_base::seekdir dir,
+                          std::ios_base::openmode which ) override;
+        pos_type seekpos( pos_type pos, std::ios_base::openmode which ) override;
+};
+
+/**
+ * Input stream reading directly from @p data. Unlike std::istringstream it does
+ * not copy the data, so the viewed memory must outlive the stream.
+ */
+class memory_istream : public std::istream
+{
+    public:
+        explicit memory_istream( std::string_view data );
+        memory_istream( const memory_istream & ) = delete;
+        memory_istream &operator=( const memory_istream & ) = delete;
+
+    private:
+        memory_streambuf buf;
+};
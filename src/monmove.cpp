@@ -333,6 +333,47 @@ float monster::rate_target( Creature &c, float best, bool smart ) const
     return FLT_MAX;
 }
 
+std::vector<const Creature *> monster::plan_sight_targets() const
+{
+    std::vector<const Creature *> targets;
+    const int sight_range = max_sight_distance();
+    const auto in_range = [&]( const Creature & c ) {
+        return rl_dist( pos(), c.pos() ) <= sight_range;
+    };
+    if( friendly == 0 && in_range( g->u ) ) {
+        targets.push_back( &g->u );
+    }
+    if( has_effect( effect_ai_waiting ) ) {
+        return targets;
+    }
+
+    // Outside of smart planning, rate_target doesn't look past the initial best rating
+    int range = sight_range;
+    if( !has_flag( MF_PRIORITIZE_TARGETS ) ) {
+        range = std::min( range, std::max( type->vision_day, type->vision_night ) );
+    }
+    const bool docile = friendly != 0 && has_effect( effect_docile );
+    for( const monster *other : g->critter_tracker->find_in_radius( pos(), range ) ) {
+        if( other == this ) {
+            continue;
+        }
+        const bool hostile = friendly != 0 ? !docile && other->friendly == 0 :
+                             faction.obj().attitude( other->faction ) != MFA_NEUTRAL &&
+                             faction.obj().attitude( other->faction ) != MFA_FRIENDLY;
+        if( hostile ) {
+            targets.push_back( other );
+        }
+    }
+    for( const npc &who : g->all_npcs() ) {
+        const mf_attitude faction_att = faction.obj().attitude( who.get_monster_faction() );
+        if( faction_att != MFA_NEUTRAL && faction_att != MFA_FRIENDLY &&
+            rl_dist( pos(), who.pos() ) <= range ) {
+            targets.push_back( &who );
+        }
+    }
+    return targets;
+}
+
 void monster::plan()
 {
     ZoneScoped;
@@ -389,11 +430,14 @@ void monster::plan()
             }
         }
         if( angers_cub_threatened > 0 ) {
-            for( monster &tmp : g->all_monsters() ) {
-                if( type->baby_monster == tmp.type->id ) {
+            // The cub is threatened when its rating of the player is at most 3, that is the distance,
+            // divided by the player's power when planning smartly. Leave slack for rounding.
+            const int cub_radius = 1 + static_cast<int>( 3 * ( smart_planning ?
+                                   std::max( 1.0f, g->u.power_rating() ) : 1.0f ) );
+            for( monster *tmp : g->critter_tracker->find_in_radius( g->u.pos(), cub_radius ) ) {
+                if( type->baby_monster == tmp->type->id ) {
                     // baby nearby; is the player too close?
-                    dist = tmp.rate_target( g->u, dist, smart_planning );
-                    if( dist <= 3 ) {
+                    if( tmp->rate_target( g->u, FLT_MAX, smart_planning ) <= 3 ) {
                         //proximity to baby; monster gets furious and less likely to flee
                         anger += angers_cub_threatened;
                         morale += angers_cub_threatened / 2;
@@ -403,11 +447,11 @@ void monster::plan()
             }
         }
     } else if( friendly != 0 && !docile && !waiting ) {
-        for( monster &tmp : g->all_monsters() ) {
-            if( tmp.friendly == 0 ) {
-                float rating = rate_target( tmp, dist, smart_planning );
+        for( monster *tmp : g->critter_tracker->find_in_radius( pos(), max_sight_distance() ) ) {
+            if( tmp->friendly == 0 ) {
+                float rating = rate_target( *tmp, dist, smart_planning );
                 if( rating < dist ) {
-                    target = &tmp;
+                    target = tmp;
                     dist = rating;
                 }
             }
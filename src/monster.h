@@ -230,6 +230,8 @@ class monster : public Creature, public location_visitable<monster>
 
         // How good of a target is given creature (checks for visibility)
         float rate_target( Creature &c, float best, bool smart = false ) const;
+        /** The creatures @ref plan may check sight of, for precomputing the checks */
+        std::vector<const Creature *> plan_sight_targets() const;
         void plan();
         void move(); // Actual movement
         void footsteps( const tripoint &p ); // noise made by movement
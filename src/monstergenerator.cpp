@@ -1060,6 +1060,10 @@ void mtype::setup_pathfinding_deferred()
 
     const bool default_override = get_option<bool>( "PATHFINDING_DEFAULT_IS_OVERRIDE" );
     const float range_mult = get_option<float>( "PATHFINDING_RANGE_MULT" );
+    // Monsters with equal settings share one d_map per destination, so rounding bash strength and speed
+    //   lets most of a mixed horde chasing the same target use the same map.
+    const int bash_quanta = std::max( 1, get_option<int>( "PATHFINDING_BASH_STRENGTH_QUANTA" ) );
+    const int speed_quanta = std::max( 1, get_option<int>( "PATHFINDING_SPEED_QUANTA" ) );
 
     if( this->has_flag( MF_CLIMBS ) ) {
         this->legacy_path_settings.climb_cost = 3;
@@ -1097,9 +1101,19 @@ void mtype::setup_pathfinding_deferred()
     extract_into_with_default( "avoid_sharp", legacy_path_settings.avoid_sharp, false );
 
     // New pathfinding init
-    extract_into_with_default( "bash_strength", this->path_settings.bash_strength_val,
-                               this->bash_skill );
-    this->path_settings.bash_strength_val /= this->path_settings.bash_strength_quanta;
+    {
+        int bash_strength;
+        extract_into_with_default( "bash_strength", bash_strength, this->bash_skill );
+        // Round down, planning through something the monster can't break gets it stuck bashing it.
+        // Anything weaker than one step keeps its exact strength so that it can still bash at all.
+        if( bash_strength >= bash_quanta ) {
+            this->path_settings.bash_strength_quanta = bash_quanta;
+            this->path_settings.bash_strength_val = bash_strength / bash_quanta;
+        } else {
+            this->path_settings.bash_strength_quanta = 1;
+            this->path_settings.bash_strength_val = std::max( 0, bash_strength );
+        }
+    }
 
     extract_into_with_default( "allow_climb_stairs", this->path_settings.can_climb_stairs, true );
 
@@ -1138,7 +1152,11 @@ void mtype::setup_pathfinding_deferred()
             }
         }
     }
-    this->path_settings.move_cost_coeff = this->speed != 0 ? 1.0 / this->speed : INFINITY;
+    {
+        const int quantized_speed = this->speed > 0 ?
+                                    std::max( 1, ( this->speed + speed_quanta / 2 ) / speed_quanta ) * speed_quanta : 0;
+        this->path_settings.move_cost_coeff = quantized_speed != 0 ? 1.0 / quantized_speed : INFINITY;
+    }
 
     // Entirely new settings that are not present in legacy pathfinding
     {
@@ -2506,6 +2506,7 @@ void npc::reboot()
     ai_cache.dangerous_explosives.clear();
     ai_cache.threat_map.clear();
     ai_cache.searched_tiles.clear();
+    ai_cache.fruitless_item_search = std::nullopt;
     activity = std::make_unique<player_activity>();
     clear_destination();
     add_effect( effect_npc_suspend, 24_hours, bodypart_str_id::NULL_ID(), 1 );
@@ -2,6 +2,8 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
+#include <cstdint>
 #include <functional>
 #include <iosfwd>
 #include <iterator>
@@ -22,6 +24,7 @@
 #include "creature.h"
 #include "cursesdef.h"
 #include "enums.h"
+#include "event_bus.h"
 #include "enum_traits.h"
 #include "faction.h"
 #include "game_constants.h"
@@ -481,6 +484,30 @@ struct healing_options {
 };
 
 // Data relevant only for this action
+// Where and when npc::find_item() last came up empty, see npc_item_search_events
+struct npc_fruitless_item_search {
+    tripoint pos;
+    std::uint64_t events = 0;
+    units::volume volume_allowed = 0_ml;
+    units::mass weight_allowed = 0_gram;
+    time_point when;
+};
+
+/**
+ * Counts the events that can leave new items around NPCs: characters dropping items
+ * and the avatar moving. A fruitless item search isn't repeated until this count
+ * changes, the NPC moves or a few turns pass.
+ */
+class npc_item_search_events : public event_subscriber
+{
+    public:
+        void notify( const cata::event & ) override;
+        /** Nothing while not subscribed, when no search result can be kept */
+        std::optional<std::uint64_t> count() const;
+    private:
+        std::uint64_t events = 0;
+};
+
 struct npc_short_term_cache {
     float danger = 0;
     float total_danger = 0;
@@ -506,6 +533,11 @@ struct npc_short_term_cache {
     std::map<direction, float> threat_map;
     // Cache of locations the NPC has searched recently in npc::find_item()
     lru_cache<tripoint, int> searched_tiles;
+    std::optional<npc_fruitless_item_search> fruitless_item_search;
+    // Wall time spent in npc::move, to spot the NPCs that slow turns down
+    std::chrono::microseconds ai_time_last_turn{ 0 };
+    std::chrono::microseconds ai_time_total{ 0 };
+    int ai_turns = 0;
 };
 
 struct npc_need_goal_cache {
@@ -921,6 +953,15 @@ class npc : public player
 
         // AI helpers
         void regen_ai_cache();
+        /** Account the time spent in @ref move during one turn */
+        void record_ai_time( std::chrono::microseconds spent );
+        std::chrono::microseconds ai_time_last_turn() const {
+            return ai_cache.ai_time_last_turn;
+        }
+        std::chrono::microseconds ai_time_average() const {
+            return ai_cache.ai_turns > 0 ? ai_cache.ai_time_total / ai_cache.ai_turns :
+                   std::chrono::microseconds( 0 );
+        }
         const Creature *current_target() const;
         Creature *current_target();
         const Creature *current_ally() const;
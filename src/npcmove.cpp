@@ -4,11 +4,13 @@
 #include <cfloat>
 #include <climits>
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
 #include <iterator>
 #include <memory>
 #include <numeric>
 #include <ostream>
+#include <set>
 #include <tuple>
 
 #include "active_item_cache.h"
@@ -22,11 +24,13 @@
 #include "character_id.h"
 #include "clzones.h"
 #include "coordinate_conversions.h"
+#include "creature_tracker.h"
 #include "damage.h"
 #include "debug.h"
 #include "dispersion.h"
 #include "effect.h"
 #include "enums.h"
+#include "event.h"
 #include "explosion.h"
 #include "field.h"
 #include "field_type.h"
@@ -35,6 +39,7 @@
 #include "game_constants.h"
 #include "gates.h"
 #include "gun_mode.h"
+#include "hierarchical_pathfinding.h"
 #include "item.h"
 #include "item_contents.h"
 #include "item_functions.h"
@@ -56,6 +61,7 @@
 #include "overmapbuffer.h"
 #include "player_activity.h"
 #include "pldata.h"
+#include "profile.h"
 #include "projectile.h"
 #include "ranged.h"
 #include "ret_val.h"
@@ -458,7 +464,10 @@ void npc::assess_danger()
         }
     }
 
-    for( const monster &critter : g->all_monsters() ) {
+    // Only monsters we could possibly see count, including friendly ones
+    for( const monster *critter_ptr : g->critter_tracker->find_in_radius( pos(),
+            max_sight_distance() ) ) {
+        const monster &critter = *critter_ptr;
         auto att = critter.attitude_to( *this );
         if( att == Attitude::A_FRIENDLY ) {
             ai_cache.friends.emplace_back( g->shared_from( critter ) );
@@ -698,8 +707,18 @@ void npc::regen_ai_cache()
     }
 }
 
+void npc::record_ai_time( const std::chrono::microseconds spent )
+{
+    ai_cache.ai_time_last_turn = spent;
+    ai_cache.ai_time_total += spent;
+    ai_cache.ai_turns++;
+}
+
 void npc::move()
 {
+    ZoneScoped;
+    ZoneText( name.c_str(), name.size() );
+
     // don't just return from this function without doing something
     // that will eventually subtract moves, or change the NPC to a different type of action.
     // because this will result in an infinite loop
@@ -2233,8 +2252,17 @@ bool npc::update_path( const tripoint &p, const bool no_bashing, bool force )
         }
     }
 
-    auto new_path = get_map().route( pos(), p, get_legacy_pathfinding_settings( no_bashing ),
-                                     get_legacy_path_avoid() );
+    const std::set<tripoint> avoid = get_legacy_path_avoid();
+    std::vector<tripoint> new_path;
+    if( !get_option<bool>( "USE_LEGACY_PATHFINDING" ) && p.z == posz() &&
+        rl_dist( pos(), p ) > 2 * SEEX ) {
+        // Long walks are planned submap by submap, see HierarchicalPathfinding
+        new_path = HierarchicalPathfinding::route( pos(), p, get_pathfinding_pair( no_bashing ).first,
+                   std::nullopt, avoid );
+    }
+    if( new_path.empty() ) {
+        new_path = get_map().route( pos(), p, get_legacy_pathfinding_settings( no_bashing ), avoid );
+    }
     if( new_path.empty() ) {
         if( !ai_cache.sound_alerts.empty() ) {
             ai_cache.sound_alerts.erase( ai_cache.sound_alerts.begin() );
@@ -2747,6 +2775,26 @@ void npc::see_item_say_smth( const itype_id &object, const std::string &smth )
     }
 }
 
+void npc_item_search_events::notify( const cata::event &e )
+{
+    switch( e.type() ) {
+        case event_type::avatar_moves:
+        case event_type::character_drops_item:
+            events++;
+            break;
+        default:
+            break;
+    }
+}
+
+std::optional<std::uint64_t> npc_item_search_events::count() const
+{
+    if( !is_subscribed() ) {
+        return std::nullopt;
+    }
+    return events;
+}
+
 void npc::find_item()
 {
     if( is_hallucination() ) {
@@ -2780,21 +2828,36 @@ void npc::find_item()
         return;
     }
 
+    // Nothing turned up last time, and nothing has happened since that could change that
+    const std::optional<std::uint64_t> search_events = g->npc_item_search_subscriber().count();
+    const tripoint abs_pos = global_square_location();
+    const std::optional<npc_fruitless_item_search> &fruitless = ai_cache.fruitless_item_search;
+    if( search_events && fruitless && fruitless->events == *search_events &&
+        fruitless->pos == abs_pos && fruitless->volume_allowed == volume_allowed &&
+        fruitless->weight_allowed == weight_allowed && calendar::turn < fruitless->when + 10_turns ) {
+        return;
+    }
+    ai_cache.fruitless_item_search = std::nullopt;
+
+    // Looked up once: it takes an overmap search per follower
+    std::vector<shared_ptr_fast<npc>> followers;
+    bool followers_found = false;
     const auto consider_item =
-        [&wanted, &best_value, whitelisting, volume_allowed, weight_allowed, this]
+        [&wanted, &best_value, &followers, &followers_found, whitelisting, volume_allowed,
+           weight_allowed, this]
     ( const item & it, const tripoint & p ) {
         if( it.made_of( LIQUID ) ) {
             // Don't even consider liquids.
             return;
         }
-        std::vector<npc *> followers;
-        for( auto &elem : g->get_follower_list() ) {
-            shared_ptr_fast<npc> npc_to_get = overmap_buffer.find_npc( elem );
-            if( !npc_to_get ) {
-                continue;
+        if( !followers_found ) {
+            for( auto &elem : g->get_follower_list() ) {
+                shared_ptr_fast<npc> npc_to_get = overmap_buffer.find_npc( elem );
+                if( npc_to_get ) {
+                    followers.push_back( npc_to_get );
+                }
             }
-            npc *npc_to_add = npc_to_get.get();
-            followers.push_back( npc_to_add );
+            followers_found = true;
         }
         Character &player_character = get_player_character();
         for( auto &elem : followers ) {
@@ -2911,6 +2974,10 @@ void npc::find_item()
     }
 
     if( wanted_name.empty() ) {
+        if( search_events ) {
+            ai_cache.fruitless_item_search = npc_fruitless_item_search{
+                abs_pos, *search_events, volume_allowed, weight_allowed, calendar::turn };
+        }
         return;
     }
 
@@ -4642,5 +4709,9 @@ bool npc::adjust_worn()
 
 void npc::set_movement_mode( character_movemode new_mode )
 {
+    if( move_mode == CMM_CROUCH || new_mode == CMM_CROUCH ) {
+        // crouching affects visibility
+        on_sight_change();
+    }
     move_mode = new_mode;
 }
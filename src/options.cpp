@@ -2266,6 +2266,21 @@ void options_manager::add_options_debug()
 
     get_option( "FOV_3D_Z_RANGE" ).setPrerequisite( "FOV_3D" );
 
+    add( "PARALLEL_MAP_CACHE", debug, translate_marker( "Parallel map cache rebuild" ),
+         translate_marker( "If true, the transparency, outside and floor caches of each z-level are rebuilt on worker threads.  Speeds up turns on multi-core machines when the world is in z-level mode." ),
+         false
+       );
+
+    add( "PARALLEL_MONSTER_SIGHT", debug, translate_marker( "Parallel monster sight" ),
+         translate_marker( "If true, the line of sight checks monsters make when choosing targets are done on worker threads before monsters act.  Monsters still act one at a time and in the usual order.  Speeds up turns with many monsters on multi-core machines." ),
+         false
+       );
+
+    add( "MAPBUFFER_MEMORY_BUDGET", debug, translate_marker( "Map memory budget" ),
+         translate_marker( "Approximate memory, in MiB, that the map tiles visited since the last save may use.  Items, creatures and vehicles on them are not counted.  When it's exceeded, the least recently visited areas outside the reality bubble are moved to a temporary file until the next save.  0 means unlimited." ),
+         0, 65536, 2048
+       );
+
     add( "ENABLE_EVENTS", debug, translate_marker( "Event bus system" ),
          translate_marker( "If false, achievements and some Magiclysm functionality won't work, but performance will be better." ),
          true
@@ -3458,6 +3473,8 @@ void options_manager::cache_to_globals()
     message_cooldown = ::get_option<int>( "MESSAGE_COOLDOWN" );
     fov_3d = ::get_option<bool>( "FOV_3D" );
     fov_3d_z_range = ::get_option<int>( "FOV_3D_Z_RANGE" );
+    parallel_map_cache = ::get_option<bool>( "PARALLEL_MAP_CACHE" );
+    parallel_monster_sight = ::get_option<bool>( "PARALLEL_MONSTER_SIGHT" );
     static_z_effect = ::get_option<bool>( "STATICZEFFECT" );
     overmap_transparency = ::get_option<bool>( "OVERMAP_TRANSPARENCY" );
     PICKUP_RANGE = ::get_option<int>( "PICKUP_RANGE" );
@@ -34,6 +34,8 @@ decltype( Pathfinding::z_area ) Pathfinding::z_area = {};
 decltype( Pathfinding::z_caches ) Pathfinding::z_caches = {};
 decltype( Pathfinding::z_caches_open_air ) Pathfinding::z_caches_open_air = {};
 decltype( Pathfinding::cached_closest_z_changes ) Pathfinding::cached_closest_z_changes = {};
+decltype( Pathfinding::z_caches_dirty ) Pathfinding::z_caches_dirty = false;
+decltype( Pathfinding::stats ) Pathfinding::stats = {};
 
 // Thanks for nothing, MVSC
 // For our MVSC builds, std::is_nan and std::is_inf are not constexpr
@@ -200,17 +202,58 @@ void Pathfinding::produce_d_map( point dest, int z, PathfindingSettings settings
 void Pathfinding::clear_d_maps()
 {
     for( auto &map : Pathfinding::d_maps ) {
-        map->reset_maps();
-        map->reset_tile_state();
-        map->unbiased_frontier.clear();
-        map->forbidden_moves.clear();
-        map->domain = Pathfinding::MapDomain::RELATIVE_DOMAIN;
-        map->is_explored = false;
+        map->reset();
         Pathfinding::d_maps_store.push_back( std::move( map ) );
     }
     Pathfinding::d_maps.clear();
     Pathfinding::cached_closest_z_changes.clear();
 }
+void Pathfinding::mark_dirty_tile( const tripoint &p )
+{
+    for( auto &map : Pathfinding::d_maps ) {
+        if( map->z != p.z || !map->in_bounds( p.xy() ) ) {
+            continue;
+        }
+        // Tile states are reset between searches but g-values are kept, so check both
+        if( map->tile_state_at( p.xy() ) == State::UNVISITED && map->g_at( p.xy() ) == 0.0 ) {
+            continue;
+        }
+        // Zero g-value means "not calculated yet", the rest of the map stays cached
+        map->g_at( p.xy() ) = 0.0;
+        map->needs_rebuild = true;
+        map->is_explored = false;
+    }
+}
+void Pathfinding::mark_dirty_z_level( const int z )
+{
+    for( auto &map : Pathfinding::d_maps ) {
+        if( map->z == z ) {
+            map->reset();
+        }
+    }
+}
+size_t Pathfinding::d_map_count()
+{
+    return Pathfinding::d_maps.size();
+}
+const PathfindingStats &Pathfinding::get_stats()
+{
+    return Pathfinding::stats;
+}
+void Pathfinding::reset_stats()
+{
+    Pathfinding::stats = PathfindingStats();
+}
+void Pathfinding::reset()
+{
+    this->reset_maps();
+    this->reset_tile_state();
+    this->unbiased_frontier.clear();
+    this->forbidden_moves.clear();
+    this->domain = Pathfinding::MapDomain::RELATIVE_DOMAIN;
+    this->is_explored = false;
+    this->needs_rebuild = false;
+}
 void Pathfinding::reset_maps()
 {
     this->p_at( this->dest ) = 0.0;
@@ -255,6 +298,17 @@ std::vector<Pathfinding::ZLevelChange> &Pathfinding::get_z_cache( const int z )
 
     return Pathfinding::z_caches[z + OVERMAP_DEPTH];
 }
+void Pathfinding::mark_dirty_z_cache()
+{
+    for( std::vector<ZLevelChange> &cache : Pathfinding::z_caches ) {
+        cache.clear();
+    }
+    for( std::unordered_map<point, ZLevelChangeOpenAirPair> &cache : Pathfinding::z_caches_open_air ) {
+        cache.clear();
+    }
+    Pathfinding::cached_closest_z_changes.clear();
+    Pathfinding::z_caches_dirty = true;
+}
 void Pathfinding::update_z_caches( bool update_open_air )
 {
     const map &here = get_map();
@@ -262,7 +316,8 @@ void Pathfinding::update_z_caches( bool update_open_air )
     point cur_z_area = here.get_abs_sub().xy();
     sm_to_ms( cur_z_area );
 
-    if( cur_z_area == Pathfinding::z_area ) {
+    const bool rescan = Pathfinding::z_caches_dirty;
+    if( cur_z_area == Pathfinding::z_area && !rescan ) {
         return;
     }
 
@@ -315,7 +370,7 @@ void Pathfinding::update_z_caches( bool update_open_air )
     // Finally, append newly loaded points
     for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
         for( const tripoint &cur : here.points_on_zlevel( z ) ) {
-            if( prev_z_volume_local.contains( cur ) ) {
+            if( !rescan && prev_z_volume_local.contains( cur ) ) {
                 continue;
             }
 
@@ -416,6 +471,7 @@ void Pathfinding::update_z_caches( bool update_open_air )
     }
 
     Pathfinding::z_area = cur_z_area;
+    Pathfinding::z_caches_dirty = false;
 }
 /// Pathfinding: main loops
 void Pathfinding::detect_culled_frontier(
@@ -462,6 +518,165 @@ void Pathfinding::detect_culled_frontier(
     out = std::move( flood_fill );
 }
 
+float Pathfinding::tile_g( const PathfindingSettings &settings, const tripoint &cur,
+                           const point &dir, const vehicle *cur_vehicle, const int cur_vehicle_part,
+                           const vehicle *next_vehicle )
+{
+    const map &here = get_map();
+    const maptile &new_tile = here.maptile_at_internal( cur );
+    const auto &terrain = new_tile.get_ter_t();
+    const auto &furniture = new_tile.get_furn_t();
+    const int move_cost = here.move_cost_internal( furniture, terrain, cur_vehicle, cur_vehicle_part );
+
+    const bool can_open_doors = !is_inf( settings.door_open_cost );
+    const bool can_bash = settings.bash_strength_val > 0;
+    const bool can_climb = !is_inf( settings.climb_cost );
+    const bool care_about_mobs = settings.mob_presence_penalty > 0;
+    const bool care_about_traps = settings.trap_cost > 0;
+
+    float cur_g = 0.0;
+    bool is_diag = dir.x != 0 && dir.y != 0;
+    cur_g += is_diag ? 0.75 * move_cost : 0.5 * move_cost;
+    cur_g *= settings.move_cost_coeff;
+
+    // First, check for trivial cost modifiers
+    const bool is_rough = move_cost > 2;
+    const bool is_sharp = terrain.has_flag( TFLAG_SHARP );
+
+    cur_g += is_rough ? settings.rough_terrain_cost : 0.0;
+    cur_g += is_sharp ? settings.sharp_terrain_cost : 0.0;
+
+    if( care_about_mobs && !std::isinf( cur_g ) ) {
+        cur_g += g->critter_at( cur, true ) != nullptr ?
+                 settings.mob_presence_penalty :
+                 0.0;
+    }
+
+    if( care_about_traps && !std::isinf( cur_g ) ) {
+        const trap &maybe_ter_trap = terrain.trap.obj();
+        const trap &maybe_trap = maybe_ter_trap.is_benign() ? new_tile.get_trap_t() : maybe_ter_trap;
+        const bool is_trap = !maybe_trap.is_benign();
+
+        cur_g += is_trap ? settings.trap_cost : 0.0;
+    }
+
+    const bool is_ledge = here.has_zlevels() && terrain.has_flag( TFLAG_NO_FLOOR );
+    if( is_ledge && !settings.can_fly ) {
+        // Close ledges outright for non-fliers
+        cur_g += INFINITY;
+    }
+
+    // And finally, add a potential field extra
+    if( !std::isinf( cur_g ) && settings.extra_g_costs.contains( cur.xy() ) ) {
+        cur_g += settings.extra_g_costs.at( cur.xy() );
+    }
+
+    const bool is_passable = move_cost != 0;
+    float obstacle_g = 0;
+    // Calculate the cost for if the tile is impassable
+    while( !std::isinf( cur_g ) && !is_passable ) {
+        const bool is_climbable = terrain.has_flag( TFLAG_CLIMBABLE );
+        const bool is_door = !!terrain.open || !!furniture.open;
+
+        if( cur_vehicle != nullptr ) {
+            // Do processing for possible vehicle first
+            const auto vpobst = vpart_position( const_cast<vehicle &>( *cur_vehicle ),
+                                                cur_vehicle_part ).obstacle_at_part();
+            const int obstacle_part = vpobst ? vpobst->part_index() : -1;
+
+            if( obstacle_part >= 0 ) {
+                int _;
+                const bool part_is_door = cur_vehicle->part_flag( obstacle_part, VPFLAG_OPENABLE );
+                const bool part_opens_from_inside = cur_vehicle->part_flag( obstacle_part, "OPENCLOSE_INSIDE" );
+                const bool is_cur_point_inside = here.veh_at_internal( cur, _ ) == next_vehicle;
+                const bool valid_to_open = part_is_door && ( part_opens_from_inside ? is_cur_point_inside : true );
+
+                if( can_open_doors && valid_to_open ) {
+                    obstacle_g = settings.door_open_cost;
+                } else if( can_bash ) {
+                    const int htd = cur_vehicle->hits_to_destroy( obstacle_part,
+                                    settings.bash_strength_val * settings.bash_strength_quanta,
+                                    DT_BASH );
+                    if( htd == 0 ) {
+                        // We cannot bash down this part
+                        obstacle_g = INFINITY;
+                        break;
+                    } else {
+                        obstacle_g = settings.bash_cost * htd;
+                        break;
+                    }
+                } else {
+                    // Nothing can be done here. Don't bother with other checks since vehicles take priority.
+                    obstacle_g = INFINITY;
+                    break;
+                }
+            }
+        }
+
+        if( is_climbable && can_climb ) {
+            obstacle_g = settings.climb_cost;
+            break;
+        }
+        if( is_door && can_open_doors ) {
+            // Doors that can only be open from the inside
+            const bool door_opens_from_inside = terrain.has_flag( "OPENCLOSE_INSIDE" ) ||
+                                                furniture.has_flag( "OPENCLOSE_INSIDE" );
+            const bool is_cur_point_inside = !here.is_outside( cur.xy() );
+            const bool valid_to_open = door_opens_from_inside ? is_cur_point_inside : true;
+            if( valid_to_open ) {
+                obstacle_g = settings.door_open_cost;
+                break;
+            }
+        }
+        if( can_bash ) {
+            // Time to consider bashing the obstacle
+            const int rating = here.bash_rating_internal(
+                                   settings.bash_strength_val * settings.bash_strength_quanta,
+                                   furniture, terrain, false, cur_vehicle, cur_vehicle_part );
+            if( rating > 1 ) {
+                obstacle_g = ( 10. / rating ) * settings.bash_cost;
+                break;
+            } else if( rating == 1 ) {
+                // Rating == 1 implies it will take at least 10 turns to take this down
+                //   which is a very unattractive target
+                //   so we'll penalize this target a lot
+                obstacle_g = 30.0 * settings.bash_cost * settings.bash_cost * settings.bash_cost;
+                break;
+            }
+
+        }
+        // We can do nothing anymore, close the tile
+        obstacle_g = INFINITY;
+        break;
+    }
+
+    cur_g += obstacle_g;
+    return cur_g;
+}
+
+float Pathfinding::step_cost( const PathfindingSettings &settings, const tripoint &from,
+                              const tripoint &to )
+{
+    const map &here = get_map();
+    int from_part;
+    int to_part;
+    const vehicle *from_vehicle = here.veh_at_internal( from, from_part );
+    const vehicle *to_vehicle = here.veh_at_internal( to, to_part );
+    if( from_vehicle != nullptr &&
+        !from_vehicle->allowed_move( from_vehicle->tripoint_to_mount( from ),
+                                     from_vehicle->tripoint_to_mount( to ) ) ) {
+        return INFINITY;
+    }
+    if( to_vehicle != nullptr &&
+        !to_vehicle->allowed_move( to_vehicle->tripoint_to_mount( from ),
+                                   to_vehicle->tripoint_to_mount( to ) ) ) {
+        return INFINITY;
+    }
+    // Like d_maps, we pay for the tile we leave
+    return Pathfinding::tile_g( settings, from, ( from - to ).xy(), from_vehicle, from_part,
+                                to_vehicle );
+}
+
 Pathfinding::ExpansionOutcome Pathfinding::expand_2d_up_to(
     const point &start,
     const RouteSettings &route_settings )
@@ -473,11 +688,13 @@ Pathfinding::ExpansionOutcome Pathfinding::expand_2d_up_to(
         return ExpansionOutcome::PATH_FOUND;
     }
 
-    const bool rebuild_needed = this->domain == MapDomain::ABSOLUTE_DOMAIN ?
-                                // Do not rebuild only if and only if
-                                //   cur domain is absolute and we are searching in absolute domain as well
-                                route_settings.is_relative_search_domain() :
-                                true;
+    const bool rebuild_needed = this->needs_rebuild ||
+                                ( this->domain == MapDomain::ABSOLUTE_DOMAIN ?
+                                  // Do not rebuild only if and only if
+                                  //   cur domain is absolute and we are searching in absolute domain as well
+                                  route_settings.is_relative_search_domain() :
+                                  true );
+    this->needs_rebuild = false;
 
     this->domain = route_settings.is_relative_search_domain() ?
                    MapDomain::RELATIVE_DOMAIN :
@@ -528,11 +745,6 @@ Pathfinding::ExpansionOutcome Pathfinding::expand_2d_up_to(
     std::unordered_set<point> culled_frontier;
     ExpansionOutcome result = ExpansionOutcome::UNSET;
 
-    const bool can_open_doors = !is_inf( this->settings.door_open_cost );
-    const bool can_bash = this->settings.bash_strength_val > 0;
-    const bool can_climb = !is_inf( this->settings.climb_cost );
-    const bool care_about_mobs = this->settings.mob_presence_penalty > 0;
-    const bool care_about_traps = this->settings.trap_cost > 0;
     const map &here = get_map();
 
     while( !biased_frontier.empty() ) {
@@ -545,6 +757,7 @@ Pathfinding::ExpansionOutcome Pathfinding::expand_2d_up_to(
         const point next_point = biased_frontier.top().second;
 
         biased_frontier.pop();
+        Pathfinding::stats.nodes_expanded++;
 
         if( !unculled_area.empty() && !unculled_area.contains( next_point ) ) {
             culled_frontier.insert( next_point );
@@ -606,133 +819,13 @@ Pathfinding::ExpansionOutcome Pathfinding::expand_2d_up_to(
                 }
             }
 
-            const maptile &new_tile = here.maptile_at_internal( cur_point_with_z );
-            const auto &terrain = new_tile.get_ter_t();
-            const auto &furniture = new_tile.get_furn_t();
-            const int move_cost = here.move_cost_internal( furniture, terrain, cur_vehicle, cur_vehicle_part );
-
             float cur_g = this->g_at( cur_point );
             // May be false for relative search, so we'll reuse g-values there
             const bool is_g_calc_needed = cur_g == 0.0;
 
             if( is_g_calc_needed ) {
-                bool is_diag = dir.x != 0 && dir.y != 0;
-                cur_g += is_diag ? 0.75 * move_cost : 0.5 * move_cost;
-                cur_g *= this->settings.move_cost_coeff;
-
-                // First, check for trivial cost modifiers
-                const bool is_rough = move_cost > 2;
-                const bool is_sharp = terrain.has_flag( TFLAG_SHARP );
-
-                cur_g += is_rough ? this->settings.rough_terrain_cost : 0.0;
-                cur_g += is_sharp ? this->settings.sharp_terrain_cost : 0.0;
-
-                if( care_about_mobs && !std::isinf( cur_g ) ) {
-                    cur_g += g->critter_at( cur_point_with_z, true ) != nullptr ?
-                             this->settings.mob_presence_penalty :
-                             0.0;
-                }
-
-                if( care_about_traps && !std::isinf( cur_g ) ) {
-                    const trap &maybe_ter_trap = terrain.trap.obj();
-                    const trap &maybe_trap = maybe_ter_trap.is_benign() ? new_tile.get_trap_t() : maybe_ter_trap;
-                    const bool is_trap = !maybe_trap.is_benign();
-
-                    cur_g += is_trap ? this->settings.trap_cost : 0.0;
-                }
-
-                const bool is_ledge = here.has_zlevels() && terrain.has_flag( TFLAG_NO_FLOOR );
-                if( is_ledge && !this->settings.can_fly ) {
-                    // Close ledges outright for non-fliers
-                    cur_g += INFINITY;
-                }
-
-                // And finally, add a potential field extra
-                if( !std::isinf( cur_g ) && this->settings.extra_g_costs.contains( cur_point ) ) {
-                    cur_g += this->settings.extra_g_costs.at( cur_point );
-                }
-
-                const bool is_passable = move_cost != 0;
-                float obstacle_g = 0;
-                // Calculate the cost for if the tile is impassable
-                while( !std::isinf( cur_g ) && !is_passable ) {
-                    const bool is_climbable = terrain.has_flag( TFLAG_CLIMBABLE );
-                    const bool is_door = !!terrain.open || !!furniture.open;
-
-                    if( cur_vehicle != nullptr ) {
-                        // Do processing for possible vehicle first
-                        const auto vpobst = vpart_position( const_cast<vehicle &>( *cur_vehicle ),
-                                                            cur_vehicle_part ).obstacle_at_part();
-                        const int obstacle_part = vpobst ? vpobst->part_index() : -1;
-
-                        if( obstacle_part >= 0 ) {
-                            int _;
-                            const bool part_is_door = cur_vehicle->part_flag( obstacle_part, VPFLAG_OPENABLE );
-                            const bool part_opens_from_inside = cur_vehicle->part_flag( obstacle_part, "OPENCLOSE_INSIDE" );
-                            const bool is_cur_point_inside = here.veh_at_internal( cur_point_with_z, _ ) == next_vehicle;
-                            const bool valid_to_open = part_is_door && ( part_opens_from_inside ? is_cur_point_inside : true );
-
-                            if( can_open_doors && valid_to_open ) {
-                                obstacle_g = this->settings.door_open_cost;
-                            } else if( can_bash ) {
-                                const int htd = cur_vehicle->hits_to_destroy( obstacle_part,
-                                                this->settings.bash_strength_val * this->settings.bash_strength_quanta,
-                                                DT_BASH );
-                                if( htd == 0 ) {
-                                    // We cannot bash down this part
-                                    obstacle_g = INFINITY;
-                                    break;
-                                } else {
-                                    obstacle_g = this->settings.bash_cost * htd;
-                                    break;
-                                }
-                            } else {
-                                // Nothing can be done here. Don't bother with other checks since vehicles take priority.
-                                obstacle_g = INFINITY;
-                                break;
-                            }
-                        }
-                    }
-
-                    if( is_climbable && can_climb ) {
-                        obstacle_g = this->settings.climb_cost;
-                        break;
-                    }
-                    if( is_door && can_open_doors ) {
-                        // Doors that can only be open from the inside
-                        const bool door_opens_from_inside = terrain.has_flag( "OPENCLOSE_INSIDE" ) ||
-                                                            furniture.has_flag( "OPENCLOSE_INSIDE" );
-                        const bool is_cur_point_inside = !here.is_outside( cur_point );
-                        const bool valid_to_open = door_opens_from_inside ? is_cur_point_inside : true;
-                        if( valid_to_open ) {
-                            obstacle_g = this->settings.door_open_cost;
-                            break;
-                        }
-                    }
-                    if( can_bash ) {
-                        // Time to consider bashing the obstacle
-                        const int rating = here.bash_rating_internal(
-                                               this->settings.bash_strength_val * this->settings.bash_strength_quanta,
-                                               furniture, terrain, false, cur_vehicle, cur_vehicle_part );
-                        if( rating > 1 ) {
-                            obstacle_g = ( 10. / rating ) * this->settings.bash_cost;
-                            break;
-                        } else if( rating == 1 ) {
-                            // Rating == 1 implies it will take at least 10 turns to take this down
-                            //   which is a very unattractive target
-                            //   so we'll penalize this target a lot
-                            obstacle_g = 30.0 * this->settings.bash_cost * this->settings.bash_cost * this->settings.bash_cost;
-                            break;
-                        }
-
-                    }
-                    // We can do nothing anymore, close the tile
-                    obstacle_g = INFINITY;
-                    break;
-                }
-
-                cur_g += obstacle_g;
-
+                cur_g = Pathfinding::tile_g( this->settings, cur_point_with_z, dir, cur_vehicle,
+                                             cur_vehicle_part, next_vehicle );
                 this->g_at( cur_point ) = cur_g;
             }
 
@@ -811,8 +904,10 @@ std::vector<tripoint> Pathfinding::get_route_2d(
     if( d_map_it == Pathfinding::d_maps.end() ) {
         Pathfinding::produce_d_map( to, z, path_settings );
         d_map = Pathfinding::d_maps.back().get();
+        Pathfinding::stats.d_map_misses++;
     } else {
         d_map = d_map_it->get();
+        Pathfinding::stats.d_map_hits++;
     }
 
     if( !d_map->is_in_limited_domain( from, from, route_settings ) ) {
@@ -1075,6 +1170,8 @@ std::vector<tripoint> Pathfinding::route(
 {
     const map &here = get_map();
 
+    Pathfinding::stats.routes++;
+
     here.clip_to_bounds( from );
     here.clip_to_bounds( to );
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <cstdint>
 #include <cstring>
 #include <map>
 #include <memory>
@@ -14,6 +15,7 @@
 #include "point.h"
 #include "rng.h"
 
+class vehicle;
 
 // A struct defining abilities of the actor and how to respond to various terrain features
 struct PathfindingSettings {
@@ -171,6 +173,18 @@ struct RouteSettings {
     constexpr bool is_relative_search_domain() const;
 };
 
+// Counters of the work done by `Pathfinding`, for benchmarks
+struct PathfindingStats {
+    // Calls to `Pathfinding::route`
+    uint64_t routes = 0;
+    // Searches on one z-level that reused a d_map of this turn
+    uint64_t d_map_hits = 0;
+    // Searches on one z-level that had to start a new d_map
+    uint64_t d_map_misses = 0;
+    // Tiles taken off the frontier while expanding d_maps
+    uint64_t nodes_expanded = 0;
+};
+
 class Pathfinding
 {
     private:
@@ -239,6 +253,10 @@ class Pathfinding
         // Global state: OPEN_AIR type z-level transitions for each z-level
         static std::array<std::unordered_map<point, ZLevelChangeOpenAirPair>, OVERMAP_LAYERS>
         z_caches_open_air;
+        // Global state: Z-level transitions must be scanned again, see `mark_dirty_z_cache`
+        static bool z_caches_dirty;
+        // Global state: see `PathfindingStats`
+        static PathfindingStats stats;
         // Global state: We cache `z_path` information taken to prevent multiple iterations for the same target
         static std::map<std::tuple<bool, int, tripoint>, ZLevelChange> cached_closest_z_changes;
 
@@ -266,6 +284,9 @@ class Pathfinding
         // Is the map already fully explored? UNVISITED tiles become INACCESSIBLE in that case.
         bool is_explored = false;
 
+        // Terrain changed under explored tiles: redo the wave from cached g-values on next expansion.
+        bool needs_rebuild = false;
+
         // We don't want to calculate dijikstra of the whole map every time,
         //   so we store wave `frontier` to proceed from later if needed
         std::vector<point> unbiased_frontier;
@@ -294,8 +315,15 @@ class Pathfinding
         // f1 = p + g + `h_coeff` * [distance between `start` and `p`]
         float get_f_biased( const point &p, const point &start, float h_coeff );
 
+        // g-value of tile `cur` when moving out of it in direction -`dir`
+        //   towards a tile occupied by `next_vehicle` [the move itself is assumed to be valid]
+        static float tile_g( const PathfindingSettings &settings, const tripoint &cur, const point &dir,
+                             const vehicle *cur_vehicle, int cur_vehicle_part, const vehicle *next_vehicle );
+
         void reset_maps();
         void reset_tile_state();
+        // Forget everything computed so far, keeping `dest`, `z` and `settings`
+        void reset();
         State &tile_state_at( const point &p );
         bool in_bounds( const point &p );
 
@@ -330,11 +358,29 @@ class Pathfinding
                                             const std::optional<PathfindingSettings> path_settings = std::nullopt,
                                             const std::optional<RouteSettings> route_settings = std::nullopt );
 
+        // Cost of stepping from `from` to adjacent `to`, INFINITY if that is impossible.
+        // Same as used by d_maps: we pay for the tile we leave.
+        static float step_cost( const PathfindingSettings &settings, const tripoint &from,
+                                const tripoint &to );
+
         // Reset whole pathfinding pretty much
         static void clear_d_maps();
 
         // Reset Z-level information. Should only be done when new Z-level changes could have appeared
         //   such as change in terrain
         static void mark_dirty_z_cache();
+
+        // Terrain or furniture at `p` changed. d_maps that reached `p` recompute its g-value
+        //   and redo their wave from the other cached g-values when next used.
+        static void mark_dirty_tile( const tripoint &p );
+
+        // Something not tracked per tile changed on `z` (e.g. a vehicle moved), start d_maps there over
+        static void mark_dirty_z_level( int z );
+
+        // Number of d_maps memoized this turn, one per destination and movement class
+        static size_t d_map_count();
+
+        static const PathfindingStats &get_stats();
+        static void reset_stats();
 };
 
@@ -4039,6 +4039,7 @@ void submap::load( JsonIn &jsin, const std::string &member_name, int version,
                 }
                 if( fld[i][j].find_field( ft ) == nullptr ) {
                     field_count++;
+                    add_active_field( point( i, j ), ft );
                 }
                 fld[i][j].add_field( ft, intensity, time_duration::from_turns( age ) );
             }
@@ -14,6 +14,7 @@
 #include "generic_factory.h"
 #include "map.h"
 #include "output.h"
+#include "profile.h"
 #include "string_id.h"
 
 static constexpr int SCENT_RADIUS = 40;
@@ -149,22 +150,19 @@ bool scent_map::inbounds( const tripoint &p ) const
 }
 void scent_map::update( const tripoint &center, map &m )
 {
-    // Stop updating scent after X turns of the player not moving.
-    // Once wind is added, need to reset this on wind shifts as well.
-    if( !player_last_position || center != *player_last_position ) {
-        player_last_position.emplace( center );
-        player_last_moved = calendar::turn;
-    } else if( player_last_moved + 1000_turns < calendar::turn ) {
-        return;
-    }
+    ZoneScoped;
 
     //the block and reduce scent properties are folded into a single scent_transfer value here
     //block=0 reduce=1 normal=5
     scent_array<char> scent_transfer;
 
-    std::array < std::array < int, 3 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > new_scent;
-    std::array < std::array < int, 3 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > sum_3_scent_y;
-    std::array < std::array < char, 3 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > squares_used_y;
+    // Both indexed [x][y] like grscent, so that the inner loops run over contiguous memory
+    // and can be vectorized. Columns are one tile wider than the scent area on each side.
+    constexpr int scent_size = SCENT_RADIUS * 2 + 1;
+    std::array < std::array < int, scent_size >, scent_size + 2 > sum_3_scent_y;
+    std::array < std::array < int, scent_size >, scent_size + 2 > squares_used_y;
+    std::array<std::array<int, scent_size>, scent_size> total;
+    std::array<std::array<int, scent_size>, scent_size> squares_used;
 
     diagonal_blocks( &blocked_cache )[MAPSIZE_X][MAPSIZE_Y] = m.access_cache(
                 center.z ).vehicle_obstructed_cache;
@@ -175,70 +173,65 @@ void scent_map::update( const tripoint &center, map &m )
     const int scentmap_miny = center.y - SCENT_RADIUS;
     const int scentmap_maxy = center.y + SCENT_RADIUS;
 
-    // The new scent flag searching function. Should be wayyy faster than the old one.
     m.scent_blockers( scent_transfer, point( scentmap_minx - 1, scentmap_miny - 1 ),
                       point( scentmap_maxx + 1, scentmap_maxy + 1 ) );
 
-    for( int x = 0; x < SCENT_RADIUS * 2 + 3; ++x ) {
-        sum_3_scent_y[0][x] = 0;
-        squares_used_y[0][x] = 0;
-        sum_3_scent_y[SCENT_RADIUS * 2][x] = 0;
-        squares_used_y[SCENT_RADIUS * 2][x] = 0;
+    // remember the sum of the scent val for the 3 neighboring squares that can defuse into
+    for( int x = 0; x < scent_size + 2; ++x ) {
+        const int *const scent = &grscent[scentmap_minx - 1 + x][scentmap_miny - 1];
+        const char *const transfer = &scent_transfer[scentmap_minx - 1 + x][scentmap_miny - 1];
+        int *const sum = sum_3_scent_y[x].data();
+        int *const used = squares_used_y[x].data();
+        for( int y = 0; y < scent_size; ++y ) {
+            sum[y] = transfer[y] * scent[y] + transfer[y + 1] * scent[y + 1] +
+                     transfer[y + 2] * scent[y + 2];
+            used[y] = transfer[y] + transfer[y + 1] + transfer[y + 2];
+        }
     }
 
-    for( int x = 0; x < SCENT_RADIUS * 2 + 3; ++x ) {
-        for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
-
-            point abs( x + scentmap_minx - 1, y + scentmap_miny );
-
-            // remember the sum of the scent val for the 3 neighboring squares that can defuse into
-            sum_3_scent_y[y][x] = 0;
-            squares_used_y[y][x] = 0;
-            for( int i = abs.y - 1; i <= abs.y + 1; ++i ) {
-                sum_3_scent_y[y][x] += scent_transfer[abs.x][i] * grscent[abs.x][i];
-                squares_used_y[y][x] += scent_transfer[abs.x][i];
-            }
+    for( int x = 0; x < scent_size; ++x ) {
+        for( int y = 0; y < scent_size; ++y ) {
+            squares_used[x][y] = squares_used_y[x][y] + squares_used_y[x + 1][y] +
+                                 squares_used_y[x + 2][y];
+            total[x][y] = sum_3_scent_y[x][y] + sum_3_scent_y[x + 1][y] + sum_3_scent_y[x + 2][y];
         }
     }
 
-    for( int x = 1; x < SCENT_RADIUS * 2 + 2; ++x ) {
-        for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
-            const point abs( x + scentmap_minx - 1, y + scentmap_miny );
-
-            int squares_used = squares_used_y[y][x - 1] + squares_used_y[y][x] + squares_used_y[y][x + 1];
-            int total = sum_3_scent_y[y][x - 1] + sum_3_scent_y[y][x] + sum_3_scent_y[y][x + 1];
-
-            //handle vehicle holes
+    //handle vehicle holes
+    for( int x = 0; x < scent_size; ++x ) {
+        for( int y = 0; y < scent_size; ++y ) {
+            const point abs( x + scentmap_minx, y + scentmap_miny );
             if( blocked_cache[abs.x][abs.y].nw && scent_transfer[abs.x + 1][abs.y + 1] == 5 ) {
-                squares_used -= 4;
-                total -= 4 * grscent[abs.x + 1][abs.y + 1];
+                squares_used[x][y] -= 4;
+                total[x][y] -= 4 * grscent[abs.x + 1][abs.y + 1];
             }
             if( blocked_cache[abs.x][abs.y].ne && scent_transfer[abs.x - 1][abs.y + 1] == 5 ) {
-                squares_used -= 4;
-                total -= 4 * grscent[abs.x - 1][abs.y + 1];
+                squares_used[x][y] -= 4;
+                total[x][y] -= 4 * grscent[abs.x - 1][abs.y + 1];
             }
             if( blocked_cache[abs.x - 1][abs.y - 1].nw && scent_transfer[abs.x - 1][abs.y - 1] == 5 ) {
-                squares_used -= 4;
-                total -= 4 * grscent[abs.x - 1][abs.y - 1];
+                squares_used[x][y] -= 4;
+                total[x][y] -= 4 * grscent[abs.x - 1][abs.y - 1];
             }
             if( blocked_cache[abs.x + 1][abs.y - 1].ne && scent_transfer[abs.x + 1][abs.y - 1] == 5 ) {
-                squares_used -= 4;
-                total -= 4 * grscent[abs.x + 1][abs.y - 1];
+                squares_used[x][y] -= 4;
+                total[x][y] -= 4 * grscent[abs.x + 1][abs.y - 1];
             }
+        }
+    }
 
+    // Every neighbour was read above, so the new values can be written in place
+    for( int x = 0; x < scent_size; ++x ) {
+        int *const scent = &grscent[scentmap_minx + x][scentmap_miny];
+        const char *const transfer = &scent_transfer[scentmap_minx + x][scentmap_miny];
+        const int *const used = squares_used[x].data();
+        const int *const sum = total[x].data();
+        for( int y = 0; y < scent_size; ++y ) {
             //Lingering scent
-            int temp_scent =  grscent[abs.x][abs.y] * ( 250 - squares_used  *
-                              scent_transfer[abs.x][abs.y] ) ;
-            temp_scent -=  grscent[abs.x][abs.y] * scent_transfer[abs.x][abs.y] *
-                           ( 45 - squares_used ) / 5;
+            int temp_scent = scent[y] * ( 250 - used[y] * transfer[y] );
+            temp_scent -= scent[y] * transfer[y] * ( 45 - used[y] ) / 5;
 
-            new_scent[y][x] = ( temp_scent + total * scent_transfer[abs.x][abs.y] ) / 250;
-
-        }
-    }
-    for( int x = 1; x < SCENT_RADIUS * 2 + 2; ++x ) {
-        for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
-            grscent[x + scentmap_minx - 1 ][y + scentmap_miny] = new_scent[y][x];
+            scent[y] = ( temp_scent + sum[y] * transfer[y] ) / 250;
         }
     }
 }
@@ -1,7 +1,6 @@
 #pragma once
 
 #include <array>
-#include <optional>
 #include <set>
 #include <string>
 #include <vector>
@@ -45,8 +44,6 @@ class scent_map
 
         scent_array<int> grscent;
         scenttype_id typescent;
-        std::optional<tripoint> player_last_position;
-        time_point player_last_moved = calendar::before_time_starts;
 
         const game &gm;
 
@@ -80,10 +80,16 @@ struct four_quadrants {
 // 1 / (e^al) where a = coefficient of absorption and l = length.
 // Factoring out length, we get 1 / (e^((a1*a2*a3*...*an)*l))
 // We merge all of the absorption values by taking their cumulative average.
+// Written as a product, which is what -ffast-math turns the division into anyway,
+// so that the exp tables below match it in every build.
 inline float sight_calc( const float &numerator, const float &transparency, const int &distance )
 {
-    return numerator / std::exp( transparency * distance );
+    return numerator * std::exp( -( transparency * distance ) );
 }
+// sight_calc with the std::exp looked up from tables kept per transparency, which are filled
+// in as distances come up. Bit-identical to sight_calc, the shadowcasting kernels use it.
+float sight_calc_from_table( const float &numerator, const float &transparency,
+                             const int &distance );
 inline bool sight_check( const float &transparency, const float &/*intensity*/ )
 {
     return transparency > LIGHT_TRANSPARENCY_SOLID;
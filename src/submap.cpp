@@ -4,7 +4,9 @@
 #include <array>
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <utility>
+#include <vector>
 
 #include "int_id.h"
 #include "mapdata.h"
@@ -38,6 +40,8 @@ void submap::swap( submap &first, submap &second )
     std::swap( first.is_uniform, second.is_uniform );
     std::swap( first.active_items, second.active_items );
     std::swap( first.field_count, second.field_count );
+    std::swap( first.active_fields, second.active_fields );
+    std::swap( first.active_fields_added, second.active_fields_added );
     std::swap( first.last_touched, second.last_touched );
     std::swap( first.spawns, second.spawns );
     std::swap( first.vehicles, second.vehicles );
@@ -236,6 +240,81 @@ submap::submap( tripoint offset ) : maptile_soa<SEEX, SEEY>( offset )
 
 submap::~submap() = default;
 
+namespace
+{
+
+// Enough for the unloading and reloading of a few map shifts worth of submaps.
+constexpr size_t max_pooled_submaps = 1024;
+
+/** Freed submap allocations kept for reuse. */
+struct submap_pool {
+    std::mutex mutex;
+    std::vector<void *> free_blocks;
+    size_t limit = max_pooled_submaps;
+
+    submap_pool() {
+        // So returning a block to the pool never allocates.
+        free_blocks.reserve( max_pooled_submaps );
+    }
+};
+
+submap_pool &get_submap_pool()
+{
+    // Never destroyed, submaps may still be deleted during static destruction.
+    static submap_pool *pool = new submap_pool();
+    return *pool;
+}
+
+} // namespace
+
+void *submap::operator new( std::size_t size )
+{
+    if( size == sizeof( submap ) ) {
+        submap_pool &pool = get_submap_pool();
+        std::lock_guard<std::mutex> lk( pool.mutex );
+        if( !pool.free_blocks.empty() ) {
+            void *ret = pool.free_blocks.back();
+            pool.free_blocks.pop_back();
+            return ret;
+        }
+    }
+    return ::operator new( size );
+}
+
+void submap::operator delete( void *ptr, std::size_t size )
+{
+    if( ptr == nullptr ) {
+        return;
+    }
+    if( size == sizeof( submap ) ) {
+        submap_pool &pool = get_submap_pool();
+        std::lock_guard<std::mutex> lk( pool.mutex );
+        if( pool.free_blocks.size() < pool.limit ) {
+            pool.free_blocks.push_back( ptr );
+            return;
+        }
+    }
+    ::operator delete( ptr );
+}
+
+void submap::set_pool_limit( size_t blocks )
+{
+    submap_pool &pool = get_submap_pool();
+    std::lock_guard<std::mutex> lk( pool.mutex );
+    pool.limit = std::min( blocks, max_pooled_submaps );
+    while( pool.free_blocks.size() > pool.limit ) {
+        ::operator delete( pool.free_blocks.back() );
+        pool.free_blocks.pop_back();
+    }
+}
+
+size_t submap::pooled_count()
+{
+    submap_pool &pool = get_submap_pool();
+    std::lock_guard<std::mutex> lk( pool.mutex );
+    return pool.free_blocks.size();
+}
+
 void submap::update_lum_rem( point p, const item &i )
 {
     is_uniform = false;
@@ -260,6 +339,33 @@ void submap::update_lum_rem( point p, const item &i )
     }
 }
 
+void submap::add_active_field( point p, const field_type_id &type )
+{
+    active_fields.emplace_back( p, type );
+    active_fields_added++;
+}
+
+void submap::remove_active_field( point p, const field_type_id &type )
+{
+    const auto iter = std::find( active_fields.begin(), active_fields.end(),
+                                 std::make_pair( p, type ) );
+    if( iter != active_fields.end() ) {
+        *iter = active_fields.back();
+        active_fields.pop_back();
+    }
+}
+
+void submap::prune_active_fields()
+{
+    std::sort( active_fields.begin(), active_fields.end() );
+    active_fields.erase( std::unique( active_fields.begin(), active_fields.end() ),
+                         active_fields.end() );
+    active_fields.erase( std::remove_if( active_fields.begin(), active_fields.end(),
+    [this]( const std::pair<point, field_type_id> &entry ) {
+        return get_field( entry.first ).find_field( entry.second ) == nullptr;
+    } ), active_fields.end() );
+}
+
 void submap::insert_cosmetic( point p, const std::string &type, const std::string &str )
 {
     cosmetic_t ins;
@@ -515,6 +621,10 @@ void submap::rotate( int turns )
         elem.pos = rotate_point( elem.pos );
     }
 
+    for( auto &elem : active_fields ) {
+        elem.first = rotate_point( elem.first );
+    }
+
     for( auto &elem : vehicles ) {
         const auto new_pos = rotate_point( elem->pos );
 
@@ -88,6 +88,18 @@ class submap : maptile_soa<SEEX, SEEY>
         submap( tripoint offset );
         ~submap();
 
+        /**
+         * Submaps are allocated from a pool of freed submaps, so loading submaps after
+         * others got unloaded reuses their memory instead of going to the allocator.
+         * @ref mapbuffer::enforce_memory_budget keeps the pool within the map memory budget.
+         */
+        static void *operator new( std::size_t size );
+        static void operator delete( void *ptr, std::size_t size );
+        /** Keep at most @p blocks freed submaps for reuse (up to 1024), freeing the rest now */
+        static void set_pool_limit( size_t blocks );
+        /** Number of freed submaps kept for reuse */
+        static size_t pooled_count();
+
         trap_id get_trap( point p ) const {
             return trp[p.x][p.y];
         }
@@ -172,6 +184,12 @@ class submap : maptile_soa<SEEX, SEEY>
             return fld[p.x][p.y];
         }
 
+        /** Keep @ref active_fields in step with a field that appeared or went away */
+        void add_active_field( point p, const field_type_id &type );
+        void remove_active_field( point p, const field_type_id &type );
+        /** Drops repeated entries and the fields that are gone from @ref active_fields */
+        void prune_active_fields();
+
         struct cosmetic_t {
             point pos;
             std::string type;
@@ -226,6 +244,14 @@ class submap : maptile_soa<SEEX, SEEY>
         active_item_cache active_items;
 
         int field_count = 0;
+        /**
+         * The fields on this submap, by tile, so that field processing can skip the
+         * empty tiles. Kept by @ref map::add_field and @ref map::remove_field; fields
+         * removed by other means stay listed until the next @ref prune_active_fields.
+         */
+        std::vector<std::pair<point, field_type_id>> active_fields;
+        /** Bumped by @ref add_active_field, to spot fields added mid-processing */
+        int active_fields_added = 0;
         time_point last_touched = calendar::turn_zero;
         std::vector<spawn_point> spawns;
         /**
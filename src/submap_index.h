@@ -0,0 +1,144 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+
+#include "point.h"
+
+/**
+ * Hash map from absolute submap coordinates to owning pointers (null means no entry).
+ *
+ * Submaps are grouped in chunks of chunk_size x chunk_size on one z-level, so the
+ * neighbouring submaps a map loads share a few hash lookups, and the chunk of the
+ * previous lookup is remembered to skip hashing for runs of nearby lookups.
+ *
+ * Iteration order is unspecified.
+ */
+template<typename Ptr>
+class submap_index
+{
+    public:
+        static constexpr int chunk_bits = 2;
+        static constexpr int chunk_size = 1 << chunk_bits;
+
+        submap_index() = default;
+        submap_index( const submap_index & ) = delete;
+        submap_index &operator=( const submap_index & ) = delete;
+
+        /** @returns the entry at @p p, or nullptr if there is none. */
+        auto *find( const tripoint &p ) const {
+            const chunk *c = find_chunk( chunk_key( p ) );
+            return c != nullptr ? c->slots[slot_index( p )].get() : nullptr;
+        }
+
+        bool contains( const tripoint &p ) const {
+            return find( p ) != nullptr;
+        }
+
+        /**
+         * Insert @p value at @p p. If there already is an entry there, nothing happens
+         * and @p value keeps ownership.
+         * @returns true if @p value was inserted.
+         */
+        bool insert( const tripoint &p, Ptr &value ) {
+            const tripoint key = chunk_key( p );
+            chunk *c = find_chunk( key );
+            if( c == nullptr ) {
+                auto inserted = chunks.emplace( key, std::make_unique<chunk>() );
+                c = inserted.first->second.get();
+                last_key = key;
+                last_chunk = c;
+            }
+            Ptr &slot = c->slots[slot_index( p )];
+            if( slot ) {
+                return false;
+            }
+            slot = std::move( value );
+            c->used++;
+            used++;
+            return true;
+        }
+
+        /** Remove the entry at @p p and return it, or a null pointer if there is none. */
+        Ptr extract( const tripoint &p ) {
+            const tripoint key = chunk_key( p );
+            chunk *c = find_chunk( key );
+            if( c == nullptr || !c->slots[slot_index( p )] ) {
+                return Ptr();
+            }
+            Ptr ret = std::move( c->slots[slot_index( p )] );
+            used--;
+            if( --c->used == 0 ) {
+                if( last_chunk == c ) {
+                    last_chunk = nullptr;
+                }
+                chunks.erase( key );
+            }
+            return ret;
+        }
+
+        void clear() {
+            last_chunk = nullptr;
+            chunks.clear();
+            used = 0;
+        }
+
+        size_t size() const {
+            return used;
+        }
+
+        bool empty() const {
+            return used == 0;
+        }
+
+        /** Call @p fn( const tripoint &, Ptr & ) for each entry. Entries must not be added or removed meanwhile. */
+        template<typename Fn>
+        void for_each( Fn &&fn ) {
+            for( auto &kv : chunks ) {
+                const tripoint origin( kv.first.x * chunk_size, kv.first.y * chunk_size, kv.first.z );
+                for( int i = 0; i < chunk_size * chunk_size; i++ ) {
+                    Ptr &slot = kv.second->slots[i];
+                    if( slot ) {
+                        fn( origin + point( i % chunk_size, i / chunk_size ), slot );
+                    }
+                }
+            }
+        }
+
+    private:
+        struct chunk {
+            std::array<Ptr, chunk_size *chunk_size> slots;
+            int used = 0;
+        };
+
+        static tripoint chunk_key( const tripoint &p ) {
+            return tripoint( p.x >> chunk_bits, p.y >> chunk_bits, p.z );
+        }
+
+        static size_t slot_index( const tripoint &p ) {
+            constexpr int mask = chunk_size - 1;
+            return ( p.y & mask ) * chunk_size + ( p.x & mask );
+        }
+
+        chunk *find_chunk( const tripoint &key ) const {
+            if( last_chunk != nullptr && last_key == key ) {
+                return last_chunk;
+            }
+            const auto it = chunks.find( key );
+            if( it == chunks.end() ) {
+                return nullptr;
+            }
+            last_key = key;
+            last_chunk = it->second.get();
+            return last_chunk;
+        }
+
+        std::unordered_map<tripoint, std::unique_ptr<chunk>> chunks;
+        size_t used = 0;
+        // Lookups come in runs of neighbouring submaps, remember the last chunk.
+        mutable tripoint last_key;
+        mutable chunk *last_chunk = nullptr;
+};
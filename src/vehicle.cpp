@@ -2590,9 +2590,9 @@ std::vector<int> vehicle::parts_at_relative( point dp,
         }
         return res;
     } else {
-        const auto &iter = relative_parts.find( dp );
-        if( iter != relative_parts.end() ) {
-            return iter->second;
+        const std::vector<int> *parts_here = relative_parts.find( dp );
+        if( parts_here != nullptr ) {
+            return *parts_here;
         } else {
             std::vector<int> res;
             return res;
@@ -2670,10 +2670,8 @@ int vehicle::part_with_feature( int part, vpart_bitflags const flag, bool unbrok
     if( part_flag( part, flag ) && ( !unbroken || !parts[part].is_broken() ) ) {
         return part;
     }
-    const auto it = relative_parts.find( parts[part].mount );
-    if( it != relative_parts.end() ) {
-        const std::vector<int> &parts_here = it->second;
-        for( auto &i : parts_here ) {
+    if( const std::vector<int> *parts_here = relative_parts.find( parts[part].mount ) ) {
+        for( auto &i : *parts_here ) {
             if( part_flag( i, flag ) && ( !unbroken || !parts[i].is_broken() ) ) {
                 return i;
             }
@@ -3994,7 +3992,7 @@ void vehicle::spew_field( double joules, int part, field_type_id type, int inten
     point p = parts[part].mount;
     intensity = std::max( joules / 10000, static_cast<double>( intensity ) );
     // Move back from engine/muffler until we find an open space
-    while( relative_parts.find( p ) != relative_parts.end() ) {
+    while( relative_parts.contains( p ) ) {
         p.x += ( velocity < 0 ? 1 : -1 );
     }
     point q = coord_translate( p );
@@ -5869,7 +5867,6 @@ void vehicle::refresh()
     water_wheels.clear();
     funnels.clear();
     emitters.clear();
-    relative_parts.clear();
     loose_parts.clear();
     wheelcache.clear();
     rail_wheelcache.clear();
@@ -5893,6 +5890,15 @@ void vehicle::refresh()
     mount_min.y = 123;
     mount_max.x = -123;
     mount_max.y = -123;
+    for( const vehicle_part &part : parts ) {
+        if( !part.removed ) {
+            mount_min.x = std::min( mount_min.x, part.mount.x );
+            mount_min.y = std::min( mount_min.y, part.mount.y );
+            mount_max.x = std::max( mount_max.x, part.mount.x );
+            mount_max.y = std::max( mount_max.y, part.mount.y );
+        }
+    }
+    relative_parts.reset( mount_min, mount_max );
 
     bool refresh_done = false;
 
@@ -5907,16 +5913,12 @@ void vehicle::refresh()
 
         // Build map of point -> all parts in that point
         const point pt = vp.mount();
-        mount_min.x = std::min( mount_min.x, pt.x );
-        mount_min.y = std::min( mount_min.y, pt.y );
-        mount_max.x = std::max( mount_max.x, pt.x );
-        mount_max.y = std::max( mount_max.y, pt.y );
+        std::vector<int> &parts_here = relative_parts[pt];
 
         // This will keep the parts at point pt sorted
-        std::vector<int>::iterator vii = std::lower_bound( relative_parts[pt].begin(),
-                                         relative_parts[pt].end(),
+        std::vector<int>::iterator vii = std::lower_bound( parts_here.begin(), parts_here.end(),
                                          static_cast<int>( p ), svpv );
-        relative_parts[pt].insert( vii, p );
+        parts_here.insert( vii, p );
 
         if( vpi.has_flag( VPFLAG_FLOATS ) ) {
             floating.push_back( p );
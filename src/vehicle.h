@@ -25,6 +25,7 @@
 #include "point.h"
 #include "tileray.h"
 #include "type_id.h"
+#include "vehicle_mount_index.h"
 
 class avatar;
 class Character;
@@ -1222,8 +1223,21 @@ class vehicle
 
         // Handle given part collision with vehicle, monster/NPC/player or terrain obstacle
         // Returns collision, which has type, impulse, part, & target.
+        // If `check_creatures` is false, the caller knows there is no creature at `p`.
         veh_collision part_collision( int part, const tripoint &p,
-                                      bool just_detect, bool bash_floor );
+                                      bool just_detect, bool bash_floor, bool check_creatures = true );
+
+        /**
+         * How the parts checked by @ref collision went: parts moving where the broadphase
+         * found no creature skip looking for one.
+         */
+        struct collision_stats {
+            int64_t calls = 0;
+            int64_t parts_checked = 0;
+            int64_t parts_culled = 0;
+        };
+        static const collision_stats &get_collision_stats();
+        static void reset_collision_stats();
 
         // Process the trap beneath
         void handle_trap( const tripoint &p, int part );
@@ -1618,7 +1632,7 @@ class vehicle
          */
         vproto_id type;
         // parts_at_relative(dp) is used a lot (to put it mildly)
-        std::map<point, std::vector<int>> relative_parts;
+        vehicle_mount_index relative_parts;
         std::set<label> labels;            // stores labels
         std::set<std::string> tags;        // Properties of the vehicle
         // After fuel consumption, this tracks the remainder of fuel < 1, and applies it the next time.
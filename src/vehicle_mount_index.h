@@ -0,0 +1,97 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "point.h"
+
+/**
+ * Indices of vehicle parts by mount point.
+ *
+ * Stored on a dense grid over the bounding box of the mount points, which for the
+ * compact shapes of vehicles wastes little space and turns a lookup into a bounds
+ * check and an array access.
+ */
+class vehicle_mount_index
+{
+    public:
+        /** @returns the parts at @p p, or nullptr if there are none. */
+        const std::vector<int> *find( point p ) const {
+            if( !in_bounds( p ) ) {
+                return nullptr;
+            }
+            const std::vector<int> &here = cells[cell_index( p )];
+            return here.empty() ? nullptr : &here;
+        }
+
+        bool contains( point p ) const {
+            return find( p ) != nullptr;
+        }
+
+        /** The parts at @p p, the grid grows to include it if needed. */
+        std::vector<int> &operator[]( point p ) {
+            if( cells.empty() ) {
+                resize( p, p );
+            } else if( !in_bounds( p ) ) {
+                resize( point( std::min( p.x, origin.x ), std::min( p.y, origin.y ) ),
+                        point( std::max( p.x, origin.x + width - 1 ), std::max( p.y, origin.y + height - 1 ) ) );
+            }
+            return cells[cell_index( p )];
+        }
+
+        /** Removes all parts and sizes the grid for mount points from @p min to @p max. */
+        void reset( point min, point max ) {
+            clear();
+            if( min.x <= max.x && min.y <= max.y ) {
+                resize( min, max );
+            }
+        }
+
+        void clear() {
+            cells.clear();
+            origin = point_zero;
+            width = 0;
+            height = 0;
+        }
+
+    private:
+        point origin;
+        int width = 0;
+        int height = 0;
+        std::vector<std::vector<int>> cells;
+
+        bool in_bounds( point p ) const {
+            return p.x >= origin.x && p.y >= origin.y &&
+                   p.x < origin.x + width && p.y < origin.y + height;
+        }
+
+        size_t cell_index( point p ) const {
+            return static_cast<size_t>( ( p.y - origin.y ) * width + ( p.x - origin.x ) );
+        }
+
+        void resize( point min, point max ) {
+            if( cells.empty() ) {
+                origin = min;
+                width = max.x - min.x + 1;
+                height = max.y - min.y + 1;
+                cells.assign( static_cast<size_t>( width ) * height, std::vector<int>() );
+                return;
+            }
+            std::vector<std::vector<int>> old_cells( static_cast<size_t>( max.x - min.x + 1 ) *
+                    ( max.y - min.y + 1 ) );
+            std::swap( old_cells, cells );
+            const point old_origin = origin;
+            const int old_width = width;
+            const int old_height = height;
+            origin = min;
+            width = max.x - min.x + 1;
+            height = max.y - min.y + 1;
+            for( int y = 0; y < old_height; y++ ) {
+                for( int x = 0; x < old_width; x++ ) {
+                    cells[cell_index( old_origin + point( x, y ) )] =
+                        std::move( old_cells[static_cast<size_t>( y ) * old_width + x] );
+                }
+            }
+        }
+};
@@ -5,16 +5,19 @@
 #include <cassert>
 #include <algorithm>
 #include <array>
+#include <climits>
 #include <cmath>
 #include <cstdlib>
 #include <memory>
 #include <optional>
 #include <ostream>
 #include <set>
+#include <unordered_set>
 
 #include "avatar.h"
 #include "bodypart.h"
 #include "creature.h"
+#include "creature_tracker.h"
 #include "debug.h"
 #include "enums.h"
 #include "explosion.h"
@@ -29,9 +32,12 @@
 #include "math_defines.h"
 #include "messages.h"
 #include "monster.h"
+#include "npc.h"
 #include "options.h"
 #include "player.h"
+#include "point.h"
 #include "point_float.h"
+#include "profile.h"
 #include "rng.h"
 #include "sounds.h"
 #include "string_id.h"
@@ -374,10 +380,56 @@ void vehicle::stop( bool update_cache )
     }
 }
 
+static vehicle::collision_stats collision_counters;
+
+const vehicle::collision_stats &vehicle::get_collision_stats()
+{
+    return collision_counters;
+}
+
+void vehicle::reset_collision_stats()
+{
+    collision_counters = collision_stats();
+}
+
+namespace
+{
+
+// Positions of all the creatures within the box from `min` to `max`,
+// leaving out the characters riding in vehicles, as part_collision does
+std::unordered_set<tripoint> creature_positions_in( const tripoint &min, const tripoint &max )
+{
+    const auto in_box = [&]( const tripoint & p ) {
+        return p.x >= min.x && p.y >= min.y && p.z >= min.z &&
+               p.x <= max.x && p.y <= max.y && p.z <= max.z;
+    };
+    const tripoint center = ( min + max ) / 2;
+    const int half_size = std::max( { max.x - center.x, max.y - center.y, max.z - center.z } ) + 1;
+    std::unordered_set<tripoint> positions;
+    // Twice the size is enough for the corners of the box to be in range with trigdist too
+    for( const monster *critter : g->critter_tracker->find_in_radius( center, half_size * 2 ) ) {
+        if( in_box( critter->pos() ) ) {
+            positions.insert( critter->pos() );
+        }
+    }
+    if( !g->u.in_vehicle && in_box( g->u.pos() ) ) {
+        positions.insert( g->u.pos() );
+    }
+    for( const npc &guy : g->all_npcs() ) {
+        if( !guy.in_vehicle && in_box( guy.pos() ) ) {
+            positions.insert( guy.pos() );
+        }
+    }
+    return positions;
+}
+
+} // namespace
+
 bool vehicle::collision( std::vector<veh_collision> &colls,
                          const tripoint &dp,
                          bool just_detect, bool bash_floor )
 {
+    ZoneScoped;
 
     /*
      * Big TODO:
@@ -417,21 +469,54 @@ bool vehicle::collision( std::vector<veh_collision> &colls,
     const int velocity_before = coll_velocity;
     int lowest_velocity = coll_velocity;
     const int sign_before = sgn( velocity_before );
-    bool empty = true;
+
+    // Broadphase: where the parts that can collide are going (dx/dy/dz and turning, precalc[1])
+    // and which of these positions have creatures in them.
+    // Looking creatures up one by one goes through all the active NPCs every time.
+    collision_counters.calls++;
+    std::vector<std::pair<int, tripoint>> targets;
+    tripoint swept_min( INT_MAX, INT_MAX, INT_MAX );
+    tripoint swept_max( INT_MIN, INT_MIN, INT_MIN );
     for( int p = 0; static_cast<size_t>( p ) < parts.size(); p++ ) {
         const vpart_info &info = part_info( p );
         if( ( info.location != part_location_structure && info.rotor_diameter() == 0 ) ||
             parts[ p ].removed ) {
             continue;
         }
-        empty = false;
-        // Coordinates of where part will go due to movement (dx/dy/dz)
-        //  and turning (precalc[1])
         const tripoint dsp = global_pos3() + dp + parts[p].precalc[1];
-        veh_collision coll = part_collision( p, dsp, just_detect, bash_floor );
+        targets.emplace_back( p, dsp );
+        swept_min = tripoint( std::min( swept_min.x, dsp.x ), std::min( swept_min.y, dsp.y ),
+                              std::min( swept_min.z, dsp.z ) );
+        swept_max = tripoint( std::max( swept_max.x, dsp.x ), std::max( swept_max.y, dsp.y ),
+                              std::max( swept_max.z, dsp.z ) );
+    }
+    std::unordered_set<tripoint> creature_positions;
+    if( !targets.empty() ) {
+        creature_positions = creature_positions_in( swept_min, swept_max );
+    }
+    TracyPlot( "Vehicle collision parts culled", collision_counters.parts_culled );
+    TracyPlot( "Vehicle collision parts checked", collision_counters.parts_checked );
+    // A part hitting a creature can push or fling it in front of the parts checked later,
+    // so from then on they are all checked in full
+    bool creatures_moved = false;
+
+    const bool empty = targets.empty();
+    for( const std::pair<int, tripoint> &target : targets ) {
+        const int p = target.first;
+        const tripoint &dsp = target.second;
+        const bool check_creatures = creatures_moved || creature_positions.contains( dsp );
+        if( check_creatures ) {
+            collision_counters.parts_checked++;
+        } else {
+            collision_counters.parts_culled++;
+        }
+        veh_collision coll = part_collision( p, dsp, just_detect, bash_floor, check_creatures );
         if( coll.type == veh_coll_nothing ) {
             continue;
         }
+        if( coll.type == veh_coll_body ) {
+            creatures_moved = true;
+        }
 
         colls.push_back( coll );
 
@@ -491,14 +576,14 @@ static void terrain_collision_data( const tripoint &p, bool bash_floor,
 }
 
 veh_collision vehicle::part_collision( int part, const tripoint &p,
-                                       bool just_detect, bool bash_floor )
+                                       bool just_detect, bool bash_floor, bool check_creatures )
 {
     // Vertical collisions need to be handled differently
     // All collisions have to be either fully vertical or fully horizontal for now
     const bool vert_coll = bash_floor || p.z != sm_pos.z;
     Character &player_character = get_player_character();
     const bool pl_ctrl = player_in_control( player_character );
-    Creature *critter = g->critter_at( p, true );
+    Creature *critter = check_creatures ? g->critter_at( p, true ) : nullptr;
     player *ph = dynamic_cast<player *>( critter );
 
     Creature *driver = pl_ctrl ? &player_character : nullptr;
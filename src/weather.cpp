@@ -148,7 +148,7 @@ inline void proc_weather_sum( const weather_type_id wtype, weather_sum &data,
 const weather_type_id &current_weather( const tripoint &location, const time_point &t )
 {
     const weather_manager &weather = get_weather();
-    const auto wgen = weather.get_cur_weather_gen();
+    const weather_generator &wgen = weather.get_cur_weather_gen();
     if( weather.weather_override ) {
         return weather.weather_override;
     }
@@ -161,6 +161,14 @@ weather_sum sum_conditions( const time_point &start, const time_point &end,
     time_duration tick_size = 0_turns;
     weather_sum data;
 
+    // Current wind at the location, doesn't change over the loop
+    const weather_manager &weather = get_weather();
+    const double local_windpower = get_local_windpower( weather.windspeed,
+                                   // TODO: fix point types
+                                   overmap_buffer.ter( tripoint_abs_omt( ms_to_omt_copy( location ) ) ),
+                                   location,
+                                   weather.winddirection, false );
+
     for( time_point t = start; t < end; t += tick_size ) {
         const time_duration diff = end - t;
         if( diff < 10_turns ) {
@@ -173,12 +181,7 @@ weather_sum sum_conditions( const time_point &start, const time_point &end,
 
         weather_type_id wtype = current_weather( location, t );
         proc_weather_sum( wtype, data, t, tick_size );
-        const weather_manager &weather = get_weather();
-        data.wind_amount += get_local_windpower( weather.windspeed,
-                            // TODO: fix point types
-                            overmap_buffer.ter( tripoint_abs_omt( ms_to_omt_copy( location ) ) ),
-                            location,
-                            weather.winddirection, false ) * to_turns<int>( tick_size );
+        data.wind_amount += local_windpower * to_turns<int>( tick_size );
     }
     return data;
 }
@@ -1155,6 +1158,39 @@ auto weather_manager::get_water_temperature( const tripoint & ) const -> units::
 void weather_manager::clear_temp_cache()
 {
     temperature_cache.clear();
+    past_temperature_cache.clear();
+}
+
+auto weather_manager::get_past_temperature( const tripoint_abs_ms &location,
+        const time_point &t ) const -> units::temperature
+{
+    // Bounds memory use when a lot of submaps are loaded in a single turn
+    static constexpr size_t max_cached = 1 << 16;
+
+    const weather_generator &wgen = get_cur_weather_gen();
+    const unsigned seed = g->get_seed();
+    if( past_temperature_gen != &wgen || past_temperature_seed != seed ||
+        past_temperature_eternal_season != calendar::config.eternal_season() ||
+        past_temperature_initial_season != calendar::config.initial_season() ) {
+        past_temperature_cache.clear();
+        past_temperature_gen = &wgen;
+        past_temperature_seed = seed;
+        past_temperature_eternal_season = calendar::config.eternal_season();
+        past_temperature_initial_season = calendar::config.initial_season();
+    }
+
+    const std::pair<point, int> key( location.raw().xy(), to_turn<int>( t ) );
+    const auto it = past_temperature_cache.find( key );
+    if( it != past_temperature_cache.end() ) {
+        return it->second;
+    }
+    if( past_temperature_cache.size() >= max_cached ) {
+        past_temperature_cache.clear();
+    }
+    const units::temperature result = wgen.get_weather_temperature( location, t, calendar::config,
+                                      seed );
+    past_temperature_cache.emplace( key, result );
+    return result;
 }
 
 namespace weather
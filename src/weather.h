@@ -3,6 +3,7 @@
 #include "calendar.h"
 #include "color.h"
 #include "coordinates.h"
+#include "hash_utils.h"
 #include "pimpl.h"
 #include "point.h"
 #include "type_id.h"
@@ -211,6 +212,15 @@ class weather_manager
         auto get_water_temperature( const tripoint &location ) const -> units::temperature;
         void clear_temp_cache();
 
+        /** generated past temperatures, cleared every turn, keyed by absolute location and turn */
+        mutable std::unordered_map<std::pair<point, int>, units::temperature, cata::tuple_hash>
+        past_temperature_cache;
+        // Returns the generated outdoor temperature of given location (absolute) at time `t`.
+        // Memoized: rot of items left outside the reality bubble is caught up hour by hour,
+        // and all the items on a tile ask for the same hours.
+        auto get_past_temperature( const tripoint_abs_ms &location,
+                                   const time_point &t ) const -> units::temperature;
+
         // Get precise weather data
         const w_point &get_precise() const {
             return weather_precise;
@@ -224,6 +234,12 @@ class weather_manager
     private:
         // Cached weather data
         w_point weather_precise;
+
+        // What past_temperature_cache was generated with, it's cleared when any of it changes
+        mutable const weather_generator *past_temperature_gen = nullptr;
+        mutable unsigned past_temperature_seed = 0;
+        mutable bool past_temperature_eternal_season = false;
+        mutable season_type past_temperature_initial_season = SPRING;
 };
 
 weather_manager &get_weather();
@@ -1,14 +1,26 @@
 #include "world.h"
 
+#include <algorithm>
 #include <sstream>
+#include <condition_variable>
 #include <cstring>
 #include <chrono>
+#include <deque>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "game.h"
 #include "avatar.h"
 #include "debug.h"
 #include "cata_utility.h"
 #include "filesystem.h"
+#include "memory_istream.h"
 #include "output.h"
 #include "worldfactory.h"
 #include "mod_manager.h"
@@ -54,6 +66,21 @@ static sqlite3 *open_db( const std::string &path )
     return db;
 }
 
+/** Opens a second connection to an existing DB, for reading it on another thread. */
+static sqlite3 *open_db_readonly( const std::string &path )
+{
+    sqlite3 *db = nullptr;
+    const int ret = sqlite3_open_v2( path.c_str(), &db, SQLITE_OPEN_READONLY, NULL );
+    if( ret != SQLITE_OK ) {
+        dbg( DL::Warn ) << "Failed to open db " << path << " for reading (Error " << ret << ")";
+        sqlite3_close( db );
+        return nullptr;
+    }
+    // The main connection may hold a lock while it commits, wait for it instead of failing.
+    sqlite3_busy_timeout( db, 1000 );
+    return db;
+}
+
 save_t::save_t( const std::string &name ): name( name ) {}
 
 std::string save_t::decoded_name() const
@@ -298,15 +325,16 @@ static bool file_exist_in_db( sqlite3 *db, const std::string &path )
     return fileCount > 0;
 }
 
-static void write_to_db( sqlite3 *db, const std::string &path, file_write_fn writer )
+static std::string serialize_for_db( file_write_fn writer )
 {
     std::ostringstream oss;
     writer( oss );
-    auto data = oss.str();
-
-    std::vector<std::byte> compressedData;
-    zlib_compress( data, compressedData );
+    return oss.str();
+}
 
+static void insert_into_db( sqlite3 *db, const std::string &path,
+                            const std::vector<std::byte> &compressedData )
+{
     size_t basePos = path.find_last_of( "/\\" );
     auto parent = ( basePos == std::string::npos ) ? "" : path.substr( 0, basePos );
 
@@ -343,8 +371,155 @@ static void write_to_db( sqlite3 *db, const std::string &path, file_write_fn wri
     sqlite3_finalize( stmt );
 }
 
-static bool read_from_db( sqlite3 *db, const std::string &path, file_read_fn reader,
-                          bool optional )
+static void write_to_db( sqlite3 *db, const std::string &path, file_write_fn writer )
+{
+    std::vector<std::byte> compressedData;
+    zlib_compress( serialize_for_db( writer ), compressedData );
+    insert_into_db( db, path, compressedData );
+}
+
+/**
+ * Writes files to the DBs in the background during a save transaction.
+ *
+ * Each file is compressed by its own async task, and a single writer thread inserts
+ * them in submission order, so the last write to a path still wins. The number of
+ * files in flight is bounded to keep memory use in check.
+ */
+class world::save_pipeline
+{
+    public:
+        save_pipeline() : max_in_flight( std::max( 2u, 2 * std::thread::hardware_concurrency() ) ),
+            writer( &save_pipeline::run, this ) {}
+
+        ~save_pipeline() {
+            {
+                std::lock_guard<std::mutex> lk( mutex );
+                stopping = true;
+            }
+            work_ready.notify_one();
+            writer.join();
+        }
+
+        save_pipeline( const save_pipeline & ) = delete;
+        save_pipeline &operator=( const save_pipeline & ) = delete;
+
+        void submit( sqlite3 *db, const std::string &path, std::string &&data ) {
+            const size_t raw_size = data.size();
+            std::future<std::vector<std::byte>> compressed = std::async( std::launch::async,
+            []( std::string data ) {
+                std::vector<std::byte> ret;
+                zlib_compress( data, ret );
+                return ret;
+            }, std::move( data ) );
+
+            std::unique_lock<std::mutex> lk( mutex );
+            work_done.wait( lk, [this]() {
+                return in_flight < max_in_flight || error;
+            } );
+            rethrow_error();
+            queue.push_back( { db, path, raw_size, std::move( compressed ) } );
+            in_flight++;
+            lk.unlock();
+            work_ready.notify_one();
+        }
+
+        void flush() {
+            std::unique_lock<std::mutex> lk( mutex );
+            work_done.wait( lk, [this]() {
+                return in_flight == 0 || error;
+            } );
+            rethrow_error();
+        }
+
+        int files_written = 0;
+        size_t raw_bytes = 0;
+        size_t compressed_bytes = 0;
+
+    private:
+        struct pending_write {
+            sqlite3 *db;
+            std::string path;
+            size_t raw_size;
+            std::future<std::vector<std::byte>> compressed;
+        };
+
+        // Must be called with the mutex held.
+        void rethrow_error() {
+            if( error ) {
+                std::exception_ptr err = std::exchange( error, nullptr );
+                std::rethrow_exception( err );
+            }
+        }
+
+        void run() {
+            std::unique_lock<std::mutex> lk( mutex );
+            while( true ) {
+                work_ready.wait( lk, [this]() {
+                    return !queue.empty() || stopping;
+                } );
+                if( queue.empty() ) {
+                    return;
+                }
+                pending_write next = std::move( queue.front() );
+                queue.pop_front();
+                lk.unlock();
+
+                std::exception_ptr failure;
+                size_t compressed_size = 0;
+                try {
+                    const std::vector<std::byte> data = next.compressed.get();
+                    compressed_size = data.size();
+                    insert_into_db( next.db, next.path, data );
+                } catch( ... ) {
+                    failure = std::current_exception();
+                }
+
+                lk.lock();
+                if( failure ) {
+                    if( !error ) {
+                        error = failure;
+                    }
+                } else {
+                    files_written++;
+                    raw_bytes += next.raw_size;
+                    compressed_bytes += compressed_size;
+                }
+                in_flight--;
+                work_done.notify_all();
+            }
+        }
+
+        const size_t max_in_flight;
+        std::mutex mutex;
+        std::condition_variable work_ready;
+        std::condition_variable work_done;
+        std::deque<pending_write> queue;
+        /** Files submitted but not yet inserted, including the one being inserted */
+        size_t in_flight = 0;
+        bool stopping = false;
+        std::exception_ptr error;
+        std::thread writer;
+};
+
+void world::write_db_file( sqlite3 *db, const std::string &path, file_write_fn writer ) const
+{
+    if( pending_writes ) {
+        pending_writes->submit( db, path, serialize_for_db( writer ) );
+    } else {
+        write_to_db( db, path, writer );
+    }
+}
+
+void world::flush_pending_writes() const
+{
+    if( pending_writes ) {
+        pending_writes->flush();
+    }
+}
+
+/** Calls @p fn with the (decompressed) contents of a file, which are only valid during the call. */
+static bool read_contents_from_db( sqlite3 *db, const std::string &path,
+                                   const std::function<void( std::string_view )> &fn, bool optional )
 {
     const char *sql = "SELECT data, compression FROM files WHERE path = :path LIMIT 1";
 
@@ -373,17 +548,19 @@ static bool read_from_db( sqlite3 *db, const std::string &path, file_read_fn rea
             return false; // Return an empty string if there's no data
         }
 
+        // Uncompressed blobs are read in place, the blob stays valid until the statement is finalized.
         std::string dataString;
+        std::string_view data;
         if( compression.empty() ) {
-            dataString = std::string( static_cast<const char *>( blobData ), blobSize );
+            data = std::string_view( static_cast<const char *>( blobData ), blobSize );
         } else if( compression == "zlib" ) {
             zlib_decompress( blobData, blobSize, dataString );
+            data = dataString;
         } else {
             throw std::runtime_error( "Unknown compression format: " + compression );
         }
 
-        std::istringstream stream( dataString );
-        reader( stream );
+        fn( data );
         sqlite3_finalize( stmt );
     } else {
         auto err = sqlite3_errmsg( db );
@@ -399,6 +576,15 @@ static bool read_from_db( sqlite3 *db, const std::string &path, file_read_fn rea
     return true;
 }
 
+static bool read_from_db( sqlite3 *db, const std::string &path, file_read_fn reader,
+                          bool optional )
+{
+    return read_contents_from_db( db, path, [&]( std::string_view data ) {
+        memory_istream stream( data );
+        reader( stream );
+    }, optional );
+}
+
 static bool read_from_db_json( sqlite3 *db, const std::string &path, file_read_json_fn reader,
                                bool optional )
 {
@@ -408,6 +594,181 @@ static bool read_from_db_json( sqlite3 *db, const std::string &path, file_read_j
     }, optional );
 }
 
+/**
+ * Reads map quads from the DB on a background thread before they are needed.
+ *
+ * Only reading and decompressing happens in the background, deserializing submaps
+ * stays on the main thread. Results are kept until taken, dropped when the file is
+ * written to, or evicted once too many are kept around.
+ *
+ * Reads go through a read-only connection owned by the prefetcher, SQLite connections
+ * must not be used by two threads at once.
+ */
+class world::quad_prefetcher
+{
+    public:
+        /** Takes ownership of `db`. */
+        explicit quad_prefetcher( sqlite3 *db ) : db( db ), reader( &quad_prefetcher::run, this ) {}
+
+        ~quad_prefetcher() {
+            {
+                std::lock_guard<std::mutex> lk( mutex );
+                stopping = true;
+            }
+            work_ready.notify_one();
+            reader.join();
+            sqlite3_close( db );
+        }
+
+        quad_prefetcher( const quad_prefetcher & ) = delete;
+        quad_prefetcher &operator=( const quad_prefetcher & ) = delete;
+
+        /** Queue a file to be read, unless it's already queued or read. */
+        void request( const std::string &path ) {
+            {
+                std::lock_guard<std::mutex> lk( mutex );
+                if( entries.contains( path ) ) {
+                    return;
+                }
+                if( entries.size() >= static_cast<size_t>( max_entries ) ) {
+                    evict_oldest();
+                }
+                entry e;
+                e.seq = next_seq++;
+                entries.emplace( path, std::move( e ) );
+                queue.push_back( path );
+            }
+            work_ready.notify_one();
+        }
+
+        /**
+         * Take the prefetched contents of a file, waiting if it's being read right now.
+         * @returns false if the file wasn't prefetched, in which case it should be read directly.
+         */
+        bool take( const std::string &path, bool &found, std::string &contents ) {
+            std::unique_lock<std::mutex> lk( mutex );
+            auto it = entries.find( path );
+            if( it == entries.end() ) {
+                return false;
+            }
+            if( it->second.state == entry_state::queued ) {
+                // Reading it right away is faster than waiting for the rest of the queue.
+                entries.erase( it );
+                return false;
+            }
+            read_done.wait( lk, [&]() {
+                it = entries.find( path );
+                return it == entries.end() || it->second.state == entry_state::done;
+            } );
+            if( it == entries.end() ) {
+                return false;
+            }
+            found = it->second.found;
+            contents = std::move( it->second.contents );
+            entries.erase( it );
+            return true;
+        }
+
+        /** Forget anything read for a file, because it's about to change. */
+        void drop( const std::string &path ) {
+            std::lock_guard<std::mutex> lk( mutex );
+            auto it = entries.find( path );
+            if( it == entries.end() ) {
+                return;
+            }
+            if( it->second.state == entry_state::reading ) {
+                it->second.stale = true;
+            } else {
+                entries.erase( it );
+            }
+        }
+
+    private:
+        enum class entry_state : int {
+            queued,
+            reading,
+            done,
+        };
+
+        struct entry {
+            /** Order of requests, for eviction */
+            int64_t seq = 0;
+            entry_state state = entry_state::queued;
+            /** Written to while it was being read, so the result is outdated */
+            bool stale = false;
+            bool found = false;
+            std::string contents;
+        };
+
+        // Must be called with the mutex held.
+        void evict_oldest() {
+            const int64_t keep_after = next_seq - max_entries / 2;
+            for( auto it = entries.begin(); it != entries.end(); ) {
+                if( it->second.seq < keep_after && it->second.state != entry_state::reading ) {
+                    it = entries.erase( it );
+                } else {
+                    ++it;
+                }
+            }
+        }
+
+        void run() {
+            std::unique_lock<std::mutex> lk( mutex );
+            while( true ) {
+                work_ready.wait( lk, [this]() {
+                    return !queue.empty() || stopping;
+                } );
+                if( stopping ) {
+                    return;
+                }
+                const std::string path = std::move( queue.front() );
+                queue.pop_front();
+                auto it = entries.find( path );
+                // Already taken, dropped or evicted.
+                if( it == entries.end() || it->second.state != entry_state::queued ) {
+                    continue;
+                }
+                it->second.state = entry_state::reading;
+                lk.unlock();
+
+                bool ok = true;
+                bool found = false;
+                std::string contents;
+                try {
+                    found = read_contents_from_db( db, path, [&]( std::string_view data ) {
+                        contents.assign( data );
+                    }, true );
+                } catch( const std::exception & ) {
+                    // Leave it to the main thread to read it again and report the error.
+                    ok = false;
+                }
+
+                lk.lock();
+                it = entries.find( path );
+                if( it->second.stale || !ok ) {
+                    entries.erase( it );
+                } else {
+                    it->second.state = entry_state::done;
+                    it->second.found = found;
+                    it->second.contents = std::move( contents );
+                }
+                read_done.notify_all();
+            }
+        }
+
+        static constexpr int max_entries = 1024;
+
+        sqlite3 *db;
+        std::mutex mutex;
+        std::condition_variable work_ready;
+        std::condition_variable read_done;
+        std::deque<std::string> queue;
+        std::unordered_map<std::string, entry> entries;
+        int64_t next_seq = 0;
+        bool stopping = false;
+        std::thread reader;
+};
+
 world::world( WORLDINFO *info )
     : info( info )
     , save_tx_start_ts( 0 )
@@ -431,6 +792,10 @@ world::~world()
         dbg( DL::Error ) << "Save transaction was not committed before world destruction";
     }
 
+    // Finish writing whatever was submitted before closing the DBs.
+    pending_writes.reset();
+    prefetched_quads.reset();
+
     if( map_db ) {
         sqlite3_close( map_db );
     }
@@ -449,6 +814,9 @@ void world::start_save_tx()
                            std::chrono::system_clock::now().time_since_epoch()
                        ).count();
 
+    // Whatever was read ahead may be written to during the transaction.
+    prefetched_quads.reset();
+
     if( map_db ) {
         sqlite3_exec( map_db, "BEGIN TRANSACTION", NULL, NULL, NULL );
     }
@@ -456,6 +824,10 @@ void world::start_save_tx()
     if( save_db ) {
         sqlite3_exec( save_db, "BEGIN TRANSACTION", NULL, NULL, NULL );
     }
+
+    if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
+        pending_writes = std::make_unique<save_pipeline>();
+    }
 }
 
 int64_t world::commit_save_tx()
@@ -464,6 +836,25 @@ int64_t world::commit_save_tx()
         throw std::runtime_error( "Attempted to commit a save transaction while none was in progress" );
     }
 
+    // Even if a write failed, the transaction is still committed with everything else.
+    std::unique_ptr<save_pipeline> pipeline = std::move( pending_writes );
+    std::exception_ptr write_error;
+    int files_written = 0;
+    size_t raw_bytes = 0;
+    size_t compressed_bytes = 0;
+    if( pipeline ) {
+        try {
+            pipeline->flush();
+            files_written = pipeline->files_written;
+            raw_bytes = pipeline->raw_bytes;
+            compressed_bytes = pipeline->compressed_bytes;
+        } catch( ... ) {
+            write_error = std::current_exception();
+        }
+        // Waits for anything still queued after a failure.
+        pipeline.reset();
+    }
+
     if( map_db ) {
         sqlite3_exec( map_db, "COMMIT", NULL, NULL, NULL );
     }
@@ -477,6 +868,16 @@ int64_t world::commit_save_tx()
                   ).count();
     int64_t duration = now - save_tx_start_ts;
     save_tx_start_ts = 0;
+    if( files_written > 0 ) {
+        const double seconds = std::max<int64_t>( duration, 1 ) / 1000.0;
+        dbg( DL::Info ) << string_format(
+                            "Saved %d files to the DB in %dms: %d KiB serialized, %d KiB compressed (%.1f MiB/s)",
+                            files_written, duration, raw_bytes / 1024, compressed_bytes / 1024,
+                            raw_bytes / ( 1024.0 * 1024.0 ) / seconds );
+    }
+    if( write_error ) {
+        std::rethrow_exception( write_error );
+    }
     return duration;
 }
 
@@ -502,6 +903,17 @@ bool world::read_map_quad( const tripoint &om_addr, file_read_json_fn reader ) c
 
     // V2 logic
     if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
+        bool found = false;
+        std::string contents;
+        if( prefetched_quads && prefetched_quads->take( quad_path, found, contents ) ) {
+            if( found ) {
+                memory_istream stream( contents );
+                JsonIn jsin( stream, quad_path );
+                reader( jsin );
+            }
+            return found;
+        }
+        flush_pending_writes();
         return read_from_db_json( map_db, quad_path, reader, true );
     } else {
         if( !file_exist( quad_path ) ) {
@@ -527,7 +939,10 @@ bool world::write_map_quad( const tripoint &om_addr, file_write_fn writer ) cons
 
     // V2 logic
     if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
-        write_to_db( map_db, quad_path, writer );
+        if( prefetched_quads ) {
+            prefetched_quads->drop( quad_path );
+        }
+        write_db_file( map_db, quad_path, writer );
         return true;
     } else {
         assure_dir_exist( dirname );
@@ -535,6 +950,27 @@ bool world::write_map_quad( const tripoint &om_addr, file_write_fn writer ) cons
     }
 }
 
+void world::prefetch_map_quad( const tripoint &om_addr )
+{
+    // The reads use their own connection on another thread, which needs a thread-safe SQLite.
+    if( info->world_save_format != save_format::V2_COMPRESSED_SQLITE3 || !map_db ||
+        sqlite3_threadsafe() == 0 ) {
+        return;
+    }
+    // Writes of the open save transaction may not be in the DB yet.
+    if( pending_writes ) {
+        return;
+    }
+    if( !prefetched_quads ) {
+        sqlite3 *reader_db = open_db_readonly( info->folder_path() + "/map.sqlite3" );
+        if( !reader_db ) {
+            return;
+        }
+        prefetched_quads = std::make_unique<quad_prefetcher>( reader_db );
+    }
+    prefetched_quads->request( get_quad_dirname( om_addr ) + "/" + get_quad_filename( om_addr ) );
+}
+
 /**
  * DOMAIN SPECIFIC: OVERMAP
  */
@@ -552,6 +988,7 @@ std::string world::overmap_player_filename( const point_abs_om &p ) const
 bool world::overmap_exists( const point_abs_om &p ) const
 {
     if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
+        flush_pending_writes();
         return file_exist_in_db( map_db, overmap_terrain_filename( p ) );
     } else {
         return file_exist( overmap_terrain_filename( p ) );
@@ -561,6 +998,7 @@ bool world::overmap_exists( const point_abs_om &p ) const
 bool world::read_overmap( const point_abs_om &p, file_read_fn reader ) const
 {
     if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
+        flush_pending_writes();
         return read_from_db( map_db, overmap_terrain_filename( p ), reader, true );
     } else {
         return read_from_file( overmap_terrain_filename( p ), reader, true );
@@ -571,6 +1009,7 @@ bool world::read_overmap_player_visibility( const point_abs_om &p, file_read_fn
 {
     if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
         sqlite3 *playerdb = get_player_db();
+        flush_pending_writes();
         return read_from_db( playerdb, overmap_player_filename( p ), reader, true );
     } else {
         return read_from_player_file( overmap_player_filename( p ), reader, true );
@@ -580,7 +1019,7 @@ bool world::read_overmap_player_visibility( const point_abs_om &p, file_read_fn
 bool world::write_overmap( const point_abs_om &p, file_write_fn writer ) const
 {
     if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
-        write_to_db( map_db, overmap_terrain_filename( p ), writer );
+        write_db_file( map_db, overmap_terrain_filename( p ), writer );
         return true;
     } else {
         return write_to_file( overmap_terrain_filename( p ), writer );
@@ -591,7 +1030,7 @@ bool world::write_overmap_player_visibility( const point_abs_om &p, file_write_f
 {
     if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
         sqlite3 *playerdb = get_player_db();
-        write_to_db( playerdb, overmap_player_filename( p ), writer );
+        write_db_file( playerdb, overmap_player_filename( p ), writer );
         return true;
     } else {
         return write_to_player_file( overmap_player_filename( p ), writer );
@@ -610,6 +1049,7 @@ bool world::read_player_mm_quad( const tripoint &p, file_read_json_fn reader )
 {
     if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
         sqlite3 *playerdb = get_player_db();
+        flush_pending_writes();
         return read_from_db_json( playerdb, get_mm_filename( p ), reader, true );
     } else {
         return read_from_player_file_json( ".mm1/" + get_mm_filename( p ), reader, true );
@@ -620,7 +1060,7 @@ bool world::write_player_mm_quad( const tripoint &p, file_write_fn writer )
 {
     if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
         sqlite3 *playerdb = get_player_db();
-        write_to_db( playerdb, get_mm_filename( p ), writer );
+        write_db_file( playerdb, get_mm_filename( p ), writer );
         return true;
     } else {
         const std::string descr = string_format(
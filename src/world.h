@@ -1,6 +1,7 @@
 #pragma once
 
 #include <functional>
+#include <memory>
 #include <string>
 #include "json.h"
 #include "options.h"
@@ -99,6 +100,11 @@ class world
          *
          * When using the V1 non-sqlite save system, this merely records some metadata
          * so we can print how long the save took.
+         *
+         * With the SQLite format, files written during the transaction are compressed on
+         * worker threads and inserted by a background writer thread. Reads made during
+         * the transaction wait for pending writes first, and commit_save_tx waits for all
+         * of them and logs how much was written.
          */
         /**@{*/
         void start_save_tx();
@@ -112,6 +118,11 @@ class world
          */
         bool read_map_quad( const tripoint &om_addr, file_read_json_fn reader ) const;
         bool write_map_quad( const tripoint &om_addr, file_write_fn writer ) const;
+        /**
+         * Start reading a map quad in the background, so a later read_map_quad doesn't
+         * have to wait for the disk. Only done for the SQLite format.
+         */
+        void prefetch_map_quad( const tripoint &om_addr );
 
         bool overmap_exists( const point_abs_om &p ) const;
         bool read_overmap( const point_abs_om &p, file_read_fn reader ) const;
@@ -178,6 +189,17 @@ class world
         sqlite3 *save_db = nullptr;
         std::string last_save_id = "";
         sqlite3 *get_player_db();
+
+        class save_pipeline;
+        /** Background writes of the current save transaction, if any */
+        std::unique_ptr<save_pipeline> pending_writes;
+        /** Write a file to the DB, through the save pipeline if a transaction is open */
+        void write_db_file( sqlite3 *db, const std::string &path, file_write_fn writer ) const;
+        /** Wait until all pending writes are in the DB, so it can be read from */
+        void flush_pending_writes() const;
+
+        class quad_prefetcher;
+        std::unique_ptr<quad_prefetcher> prefetched_quads;
 };
 
 
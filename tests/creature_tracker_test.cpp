@@ -0,0 +1,98 @@
+#include "catch/catch.hpp"
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+#include "avatar.h"
+#include "creature_tracker.h"
+#include "game.h"
+#include "line.h"
+#include "map_helpers.h"
+#include "monster.h"
+#include "point.h"
+#include "rng.h"
+#include "state_helpers.h"
+
+static std::set<const monster *> brute_force_in_radius( const tripoint &center, int radius )
+{
+    std::set<const monster *> result;
+    for( const monster &critter : g->all_monsters() ) {
+        if( rl_dist( center, critter.pos() ) <= radius ) {
+            result.insert( &critter );
+        }
+    }
+    return result;
+}
+
+static std::set<const monster *> indexed_in_radius( const tripoint &center, int radius )
+{
+    const std::vector<monster *> found = g->critter_tracker->find_in_radius( center, radius );
+    CHECK( found.size() == std::set<monster *>( found.begin(), found.end() ).size() );
+    return std::set<const monster *>( found.begin(), found.end() );
+}
+
+TEST_CASE( "creature_tracker_finds_monsters_in_radius", "[creature_tracker]" )
+{
+    clear_all_state();
+    put_player_underground();
+
+    std::vector<monster *> zombies;
+    for( int i = 0; i < 40; i++ ) {
+        const tripoint p( 10 + ( i % 8 ) * 13, 10 + ( i / 8 ) * 21, 0 );
+        zombies.push_back( &spawn_test_monster( "mon_zombie", p ) );
+    }
+
+    const auto check_queries = []() {
+        for( const tripoint &center : {
+                 tripoint( 0, 0, 0 ), tripoint( 30, 40, 0 ), tripoint( 66, 66, 0 ), tripoint( 120, 90, 0 )
+             } ) {
+            for( int radius : { 0, 5, 16, 40 } ) {
+                CAPTURE( center, radius );
+                CHECK( indexed_in_radius( center, radius ) == brute_force_in_radius( center, radius ) );
+            }
+        }
+    };
+    check_queries();
+
+    SECTION( "after monsters move" ) {
+        for( monster *zombie : zombies ) {
+            const tripoint dest = zombie->pos() + tripoint( rng( -5, 5 ), rng( -5, 5 ), 0 );
+            if( g->critter_at( dest ) == nullptr ) {
+                zombie->setpos( dest );
+            }
+        }
+        check_queries();
+    }
+
+    SECTION( "after monsters swap places" ) {
+        g->swap_critters( *zombies[0], *zombies[39] );
+        check_queries();
+    }
+
+    SECTION( "after monsters die and are removed" ) {
+        for( size_t i = 0; i < zombies.size(); i += 3 ) {
+            zombies[i]->die( nullptr );
+        }
+        check_queries();
+        g->critter_tracker->remove_dead();
+        check_queries();
+    }
+
+    SECTION( "after the cache is rebuilt" ) {
+        g->critter_tracker->rebuild_cache();
+        check_queries();
+    }
+
+    SECTION( "creatures_in_radius filters by predicate and includes characters" ) {
+        const tripoint center = zombies[9]->pos();
+        const std::vector<Creature *> found = g->creatures_in_radius( center, 30,
+        []( const Creature & critter ) {
+            return critter.is_monster();
+        } );
+        CHECK( found.size() == brute_force_in_radius( center, 30 ).size() );
+
+        const std::vector<Creature *> around_player = g->creatures_in_radius( g->u.pos(), 0 );
+        CHECK( std::find( around_player.begin(), around_player.end(), &g->u ) != around_player.end() );
+    }
+}
@@ -443,3 +443,119 @@ TEST_CASE( "grid_furn_transform_queue_outside_bubble", "[grids]" )
     REQUIRE( sm->get_furn( pos_in_sm.raw() ).id() == f_floor_lamp_on );
     REQUIRE( active_tiles::furn_at<steady_consumer_tile>( pos_abs ) != nullptr );
 }
+
+TEST_CASE( "grid_battery_totals_match_batteries", "[grids]" )
+{
+    clear_all_state();
+    put_player_underground();
+    map &m = get_map();
+    clear_grid_connections( m );
+
+    // All on one submap, so on one grid
+    std::vector<tripoint> battery_positions;
+    for( int x = 1; x < SEEX - 1; x++ ) {
+        battery_positions.emplace_back( x, 12, 0 );
+        m.furn_set( battery_positions.back(), f_battery );
+    }
+    const tripoint_abs_ms grid_pos( m.getabs( battery_positions.front() ) );
+
+    const auto check_totals = [&]() {
+        distribution_grid &grid = get_distribution_grid_tracker().grid_at( grid_pos );
+        int stored = 0;
+        for( const tripoint_abs_ms &p : grid.get_contents() ) {
+            if( const battery_tile *battery = active_tiles::furn_at<battery_tile>( p ) ) {
+                stored += battery->get_resource();
+            }
+        }
+        CHECK( grid.get_resource( false ) == stored );
+        CHECK( grid.get_resource( true ) == stored );
+        return stored;
+    };
+    distribution_grid &grid = get_distribution_grid_tracker().grid_at( grid_pos );
+    battery_tile *first_battery = active_tiles::furn_at<battery_tile>( grid_pos );
+    REQUIRE( first_battery != nullptr );
+    const int battery_capacity = first_battery->max_stored;
+    const int capacity = battery_capacity * static_cast<int>( battery_positions.size() );
+    REQUIRE( check_totals() == 0 );
+
+    WHEN( "the grid is charged and discharged" ) {
+        CHECK( grid.mod_resource( battery_capacity * 3 + 5 ) == 0 );
+        CHECK( check_totals() == battery_capacity * 3 + 5 );
+        CHECK( grid.mod_resource( -battery_capacity ) == 0 );
+        CHECK( check_totals() == battery_capacity * 2 + 5 );
+    }
+
+    WHEN( "a battery is charged directly" ) {
+        CHECK( first_battery->mod_resource( 7 ) == 0 );
+        CHECK( check_totals() == 7 );
+    }
+
+    WHEN( "the grid is overcharged" ) {
+        CHECK( grid.mod_resource( capacity + 100 ) == 100 );
+        CHECK( check_totals() == capacity );
+        THEN( "further charge is returned" ) {
+            CHECK( grid.mod_resource( 10, false ) == 10 );
+            CHECK( check_totals() == capacity );
+        }
+        AND_WHEN( "it is drained past empty" ) {
+            CHECK( grid.mod_resource( -capacity - 30 ) == -30 );
+            CHECK( check_totals() == 0 );
+            CHECK( grid.mod_resource( -10, false ) == -10 );
+        }
+    }
+
+    WHEN( "batteries are removed and added" ) {
+        CHECK( grid.mod_resource( capacity ) == 0 );
+        m.furn_set( battery_positions[3], furn_str_id::NULL_ID() );
+        CHECK( check_totals() == capacity - battery_capacity );
+        m.furn_set( battery_positions[3], f_battery );
+        CHECK( check_totals() == capacity - battery_capacity );
+        CHECK( grid.mod_resource( battery_capacity + 1 ) == 1 );
+        CHECK( check_totals() == capacity );
+    }
+}
+
+TEST_CASE( "grid_battery_totals_are_kept_per_grid", "[grids]" )
+{
+    clear_all_state();
+    put_player_underground();
+    map &m = get_map();
+    clear_grid_connections( m );
+
+    // A few overmap tiles apart, so on separate grids
+    const tripoint pos_a( 5, 12, 0 );
+    const tripoint pos_b( 5 + 4 * SEEX, 12, 0 );
+    m.furn_set( pos_a, f_battery );
+    m.furn_set( pos_b, f_battery );
+    const tripoint_abs_ms abs_a( m.getabs( pos_a ) );
+    const tripoint_abs_ms abs_b( m.getabs( pos_b ) );
+    distribution_grid_tracker &tracker = get_distribution_grid_tracker();
+    distribution_grid &grid_a = tracker.grid_at( abs_a );
+    distribution_grid &grid_b = tracker.grid_at( abs_b );
+    REQUIRE( &grid_a != &grid_b );
+    CHECK( grid_b.mod_resource( 10, false ) == 0 );
+    REQUIRE( grid_a.get_resource( false ) == 0 );
+    REQUIRE( grid_b.get_resource( false ) == 10 );
+
+    WHEN( "one grid is charged" ) {
+        const std::uint64_t recounts = distribution_grid::battery_recounts;
+        for( int i = 1; i <= 5; i++ ) {
+            CHECK( grid_a.mod_resource( 3, false ) == 0 );
+            CHECK( grid_a.get_resource( false ) == 3 * i );
+            CHECK( grid_b.get_resource( false ) == 10 );
+        }
+        THEN( "neither grid sums up its batteries again" ) {
+            CHECK( distribution_grid::battery_recounts == recounts );
+        }
+    }
+
+    WHEN( "a battery is charged without going through its grid" ) {
+        battery_tile *battery_b = active_tiles::furn_at<battery_tile>( abs_b );
+        REQUIRE( battery_b != nullptr );
+        CHECK( battery_b->mod_resource( 5 ) == 0 );
+        THEN( "the grids notice" ) {
+            CHECK( grid_b.get_resource( false ) == 15 );
+            CHECK( grid_a.get_resource( false ) == 0 );
+        }
+    }
+}
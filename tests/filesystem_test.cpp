@@ -7,6 +7,7 @@
 #include "string_formatter.h"
 #include "path_info.h"
 #include "game.h"
+#include "json.h"
 #include "world.h"
 #include "cata_utility.h"
 
@@ -206,3 +207,85 @@ TEST_CASE( "filesystem_utf8_decomp", "[filesystem]" )
     // French (should stay decomposed)
     filesystem_test_group( 7, "cre\u0300me bru\u0302le\u0301e", "re\u0300m", "ru\u0302le\u0301" );
 }
+
+TEST_CASE( "world_save_tx_reads_pending_writes", "[filesystem]" )
+{
+    world *w = g->get_active_world();
+    REQUIRE( w != nullptr );
+
+    // Far away from anywhere the tests generate map data.
+    const auto quad = []( int i ) {
+        return tripoint( 100000 + i, 100000, 0 );
+    };
+    const auto write_quad = [&]( int i, const std::string &contents ) {
+        REQUIRE( w->write_map_quad( quad( i ), [&]( std::ostream & fout ) {
+            JsonOut jsout( fout );
+            jsout.write( contents );
+        } ) );
+    };
+    const auto read_quad = [&]( int i ) {
+        std::string ret;
+        w->read_map_quad( quad( i ), [&]( JsonIn & jsin ) {
+            ret = jsin.get_string();
+        } );
+        return ret;
+    };
+
+    const int num_quads = 64;
+    w->start_save_tx();
+    for( int i = 0; i < num_quads; i++ ) {
+        write_quad( i, "first " + std::to_string( i ) );
+    }
+    // Later writes to the same file win, and reads see writes still in flight.
+    write_quad( 0, "second" );
+    CHECK( read_quad( 0 ) == "second" );
+    CHECK( read_quad( num_quads - 1 ) == "first " + std::to_string( num_quads - 1 ) );
+    write_quad( 1, "second" );
+    w->commit_save_tx();
+
+    CHECK( read_quad( 0 ) == "second" );
+    CHECK( read_quad( 1 ) == "second" );
+    for( int i = 2; i < num_quads; i++ ) {
+        CHECK( read_quad( i ) == "first " + std::to_string( i ) );
+    }
+}
+
+TEST_CASE( "world_prefetched_quads_stay_current", "[filesystem]" )
+{
+    world *w = g->get_active_world();
+    REQUIRE( w != nullptr );
+
+    const tripoint quad( 100000, 100100, 0 );
+    const auto write_quad = [&]( const std::string &contents ) {
+        REQUIRE( w->write_map_quad( quad, [&]( std::ostream & fout ) {
+            JsonOut jsout( fout );
+            jsout.write( contents );
+        } ) );
+    };
+    const auto read_quad = [&]() {
+        std::string ret;
+        w->read_map_quad( quad, [&]( JsonIn & jsin ) {
+            ret = jsin.get_string();
+        } );
+        return ret;
+    };
+
+    write_quad( "first" );
+    w->prefetch_map_quad( quad );
+    CHECK( read_quad() == "first" );
+
+    // Writing after a prefetch must not leave the old contents around.
+    w->prefetch_map_quad( quad );
+    write_quad( "second" );
+    CHECK( read_quad() == "second" );
+    w->prefetch_map_quad( quad );
+    CHECK( read_quad() == "second" );
+
+    // A save transaction drops whatever was read ahead before it.
+    w->prefetch_map_quad( quad );
+    w->start_save_tx();
+    write_quad( "third" );
+    CHECK( read_quad() == "third" );
+    w->commit_save_tx();
+    CHECK( read_quad() == "third" );
+}
@@ -7,6 +7,7 @@
 #include "json.h"
 #include "cached_options.h"
 #include "cata_utility.h"
+#include "memory_istream.h"
 #include "string_formatter.h"
 #include "type_id.h"
 
@@ -481,3 +482,46 @@ TEST_CASE( "serialize_optional", "[json]" )
         test_serialization( v, "[1,2,3]" );
     }
 }
+
+TEST_CASE( "jsonin_memory_stream", "[json]" )
+{
+    restore_on_out_of_scope<error_log_format_t> restore_error_log_format( error_log_format );
+    error_log_format = error_log_format_t::human_readable;
+
+    const std::string json = R"({ "b": [ 1, 2, 3 ], "a": "foo", "c": { "d": true } })";
+    memory_istream is( json );
+    JsonIn jsin( is );
+    JsonObject jo = jsin.get_object();
+    // members are read out of order, which seeks back and forth in the stream
+    CHECK( jo.get_string( "a" ) == "foo" );
+    CHECK( jo.get_int_array( "b" ) == std::vector<int> { 1, 2, 3 } );
+    CHECK( jo.get_object( "c" ).get_bool( "d" ) );
+    CHECK( jo.get_string( "a" ) == "foo" );
+
+    // error locations are the same as with a copying stream
+    const auto error_message = []( std::istream & stream ) {
+        JsonIn err_jsin( stream );
+        JsonObject err_jo = err_jsin.get_object();
+        err_jo.allow_omitted_members();
+        try {
+            err_jo.get_int( "a" );
+        } catch( const JsonError &err ) {
+            return std::string( err.what() );
+        }
+        return std::string();
+    };
+    std::istringstream copied( json );
+    memory_istream viewed( json );
+    const std::string expected = error_message( copied );
+    CHECK_FALSE( expected.empty() );
+    CHECK( error_message( viewed ) == expected );
+
+    // seeking outside the buffer fails without moving the stream
+    memory_istream bounds( json );
+    bounds.seekg( 5 );
+    CHECK( bounds.tellg() == 5 );
+    bounds.seekg( json.size() + 1 );
+    CHECK( bounds.fail() );
+    bounds.clear();
+    CHECK( bounds.tellg() == 5 );
+}
@@ -0,0 +1,79 @@
+#include "catch/catch.hpp"
+
+#include "lru_cache.h"
+#include "point.h"
+
+TEST_CASE( "lru_cache_insert_get_remove", "[lru_cache]" )
+{
+    lru_cache<point, char> cache;
+    CHECK( cache.get( point_zero, -1 ) == -1 );
+
+    cache.insert( 10, point_zero, 1 );
+    cache.insert( 10, point_east, 2 );
+    CHECK( cache.size() == 2 );
+    CHECK( cache.get( point_zero, -1 ) == 1 );
+    CHECK( cache.get( point_east, -1 ) == 2 );
+
+    cache.insert( 10, point_zero, 3 );
+    CHECK( cache.size() == 2 );
+    CHECK( cache.get( point_zero, -1 ) == 3 );
+
+    cache.remove( point_zero );
+    CHECK( cache.size() == 1 );
+    CHECK( cache.get( point_zero, -1 ) == -1 );
+    CHECK( cache.get( point_east, -1 ) == 2 );
+
+    cache.clear();
+    CHECK( cache.size() == 0 );
+    CHECK( cache.get( point_east, -1 ) == -1 );
+}
+
+TEST_CASE( "lru_cache_respects_limit", "[lru_cache]" )
+{
+    constexpr int limit = 100;
+    lru_cache<tripoint, int> cache;
+    for( int i = 0; i < 10 * limit; ++i ) {
+        cache.insert( limit, tripoint( i, -i, 0 ), i );
+        CHECK( cache.size() <= static_cast<size_t>( limit ) );
+    }
+    CHECK( cache.size() == static_cast<size_t>( limit ) );
+    CHECK( cache.stats().evictions == 9 * limit );
+    // The entry inserted last can't have been evicted
+    CHECK( cache.get( tripoint( 10 * limit - 1, 1 - 10 * limit, 0 ), -1 ) == 10 * limit - 1 );
+}
+
+TEST_CASE( "lru_cache_keeps_recently_used_entries", "[lru_cache]" )
+{
+    constexpr int limit = 8;
+    lru_cache<tripoint, int> cache;
+    for( int i = 0; i < limit; ++i ) {
+        cache.insert( limit, tripoint( i, 0, 0 ), i );
+    }
+    // The first eviction sweeps the whole table and clears every mark,
+    // after that only entries that are read again are protected
+    cache.insert( limit, tripoint( limit, 0, 0 ), limit );
+    for( int i = 0; i < limit; ++i ) {
+        const tripoint p( i, 0, 0 );
+        if( cache.get( p, -1 ) == -1 ) {
+            continue;
+        }
+        cache.insert( limit, tripoint( limit + 1, 0, 0 ), limit + 1 );
+        CHECK( cache.get( p, -1 ) == i );
+        CHECK( cache.get( tripoint( limit, 0, 0 ), -1 ) == limit );
+        break;
+    }
+}
+
+TEST_CASE( "lru_cache_counts_hits_and_misses", "[lru_cache]" )
+{
+    lru_cache<tripoint, int> cache;
+    cache.insert( 4, tripoint_zero, 1 );
+    cache.get( tripoint_zero, 0 );
+    cache.get( tripoint_zero, 0 );
+    cache.get( tripoint_east, 0 );
+    CHECK( cache.stats().hits == 2 );
+    CHECK( cache.stats().misses == 1 );
+    cache.reset_stats();
+    CHECK( cache.stats().hits == 0 );
+    CHECK( cache.stats().misses == 0 );
+}
@@ -1,16 +1,26 @@
 #include "catch/catch.hpp"
 
+#include <algorithm>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "avatar.h"
+#include "cached_options.h"
+#include "calendar.h"
+#include "cata_utility.h"
 #include "enums.h"
 #include "game.h"
 #include "game_constants.h"
+#include "lightmap.h"
 #include "map.h"
 #include "map_helpers.h"
+#include "mapbuffer.h"
+#include "mapdata.h"
+#include "options_helpers.h"
 #include "point.h"
 #include "state_helpers.h"
+#include "submap.h"
 #include "type_id.h"
 
 TEST_CASE( "destroy_grabbed_furniture" )
@@ -144,3 +154,160 @@ TEST_CASE( "bash_through_roof_can_destroy_multiple_times" )
         }
     }
 }
+
+namespace
+{
+struct level_cache_snapshot {
+    std::vector<float> transparency;
+    std::vector<bool> outside;
+    std::vector<bool> floor;
+};
+} // namespace
+
+static std::vector<level_cache_snapshot> rebuild_and_snapshot_level_caches( map &here )
+{
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+        here.set_transparency_cache_dirty( z );
+        here.set_outside_cache_dirty( z );
+        here.set_floor_cache_dirty( z );
+    }
+    here.build_map_cache( 0, true );
+
+    std::vector<level_cache_snapshot> result;
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+        const level_cache &ch = here.get_cache_ref( z );
+        level_cache_snapshot &snap = result.emplace_back();
+        for( int x = 0; x < MAPSIZE_X; x++ ) {
+            for( int y = 0; y < MAPSIZE_Y; y++ ) {
+                snap.transparency.push_back( ch.transparency_cache[x][y] );
+                snap.outside.push_back( ch.outside_cache[x][y] );
+                snap.floor.push_back( ch.floor_cache[x][y] );
+            }
+        }
+    }
+    return result;
+}
+
+TEST_CASE( "parallel_map_cache_matches_serial", "[map][lightmap]" )
+{
+    clear_all_state();
+    map &here = get_map();
+    REQUIRE( here.has_zlevels() );
+
+    const tripoint p( 65, 65, 0 );
+    here.ter_set( p, ter_id( "t_brick_wall" ) );
+    here.ter_set( p + tripoint_east, ter_id( "t_floor" ) );
+    here.ter_set( p + tripoint_above, ter_id( "t_open_air" ) );
+    here.ter_set( p + tripoint( 0, 2, -1 ), ter_id( "t_floor" ) );
+    here.add_field( p + tripoint( 3, 0, 2 ), field_type_id( "fd_smoke" ), 3 );
+
+    restore_on_out_of_scope<bool> restore_parallel( parallel_map_cache );
+    parallel_map_cache = false;
+    const std::vector<level_cache_snapshot> serial = rebuild_and_snapshot_level_caches( here );
+    parallel_map_cache = true;
+    const std::vector<level_cache_snapshot> parallel = rebuild_and_snapshot_level_caches( here );
+
+    REQUIRE( serial.size() == parallel.size() );
+    for( size_t i = 0; i < serial.size(); i++ ) {
+        INFO( "z-level " << static_cast<int>( i ) - OVERMAP_DEPTH );
+        CHECK( serial[i].transparency == parallel[i].transparency );
+        CHECK( serial[i].outside == parallel[i].outside );
+        CHECK( serial[i].floor == parallel[i].floor );
+    }
+}
+
+TEST_CASE( "mapbuffer_evicts_far_submaps_over_budget", "[map]" )
+{
+    clear_all_state();
+    // Far outside the reality bubble.
+    const tripoint far_sm( 1000, 1000, 0 );
+    {
+        tinymap tm;
+        tm.load( far_sm, false );
+        tm.furn_set( tripoint( 5, 5, 0 ), furn_id( "f_chair" ) );
+    }
+    REQUIRE( MAPBUFFER.is_submap_loaded( far_sm ) );
+
+    {
+        override_option budget( "MAPBUFFER_MEMORY_BUDGET", "1" );
+        MAPBUFFER.enforce_memory_budget();
+    }
+    CHECK_FALSE( MAPBUFFER.is_submap_loaded( far_sm ) );
+    CHECK( MAPBUFFER.is_submap_loaded( get_map().get_abs_sub() ) );
+    // Still over the budget, so the freed submaps aren't kept around for reuse either.
+    CHECK( submap::pooled_count() == 0 );
+
+    // Evicted submaps come back as they were.
+    submap *sm = MAPBUFFER.lookup_submap( far_sm );
+    REQUIRE( sm != nullptr );
+    CHECK( sm->get_furn( point( 5, 5 ) ) == furn_id( "f_chair" ) );
+}
+
+TEST_CASE( "mapbuffer_waits_for_new_submaps_after_a_pass_over_budget", "[map]" )
+{
+    clear_all_state();
+    override_option budget( "MAPBUFFER_MEMORY_BUDGET", "1" );
+    // The reality bubble alone doesn't fit, so this pass can't get under the budget.
+    MAPBUFFER.enforce_memory_budget();
+    REQUIRE( MAPBUFFER.is_submap_loaded( get_map().get_abs_sub() ) );
+
+    const tripoint far_sm( 1000, 1000, 0 );
+    {
+        tinymap tm;
+        tm.load( far_sm, false );
+        tm.furn_set( tripoint( 5, 5, 0 ), furn_id( "f_chair" ) );
+    }
+    REQUIRE( MAPBUFFER.is_submap_loaded( far_sm ) );
+    // A single new quad isn't worth scanning everything again.
+    MAPBUFFER.enforce_memory_budget();
+    CHECK( MAPBUFFER.is_submap_loaded( far_sm ) );
+
+    // After a save, the next pass looks again.
+    MAPBUFFER.save();
+    submap *sm = MAPBUFFER.lookup_submap( far_sm );
+    REQUIRE( sm != nullptr );
+    MAPBUFFER.enforce_memory_budget();
+    CHECK_FALSE( MAPBUFFER.is_submap_loaded( far_sm ) );
+    sm = MAPBUFFER.lookup_submap( far_sm );
+    REQUIRE( sm != nullptr );
+    CHECK( sm->get_furn( point( 5, 5 ) ) == furn_id( "f_chair" ) );
+}
+
+TEST_CASE( "active_field_list_matches_fields_as_gas_spreads", "[map][field]" )
+{
+    clear_all_state();
+    map &here = get_map();
+    const tripoint origin( 66, 66, 0 );
+    for( const tripoint &p : here.points_in_radius( origin, 12 ) ) {
+        here.ter_set( p, t_floor );
+    }
+    here.add_field( origin, field_type_id( "fd_smoke" ), 3 );
+    here.add_field( origin + point_east, field_type_id( "fd_blood" ), 1 );
+    here.remove_field( origin + point_east, field_type_id( "fd_blood" ) );
+    for( int turn = 0; turn < 5; turn++ ) {
+        calendar::turn += 1_turns;
+        here.process_fields();
+    }
+
+    size_t fields = 0;
+    for( int smx = 4; smx <= 6; smx++ ) {
+        for( int smy = 4; smy <= 6; smy++ ) {
+            submap *sm = MAPBUFFER.lookup_submap( here.get_abs_sub() + tripoint( smx, smy, 0 ) );
+            REQUIRE( sm != nullptr );
+            sm->prune_active_fields();
+            size_t on_tiles = 0;
+            for( int x = 0; x < SEEX; x++ ) {
+                for( int y = 0; y < SEEY; y++ ) {
+                    for( const auto &fp : sm->get_field( point( x, y ) ) ) {
+                        on_tiles++;
+                        CHECK( std::count( sm->active_fields.begin(), sm->active_fields.end(),
+                                           std::make_pair( point( x, y ), fp.first ) ) == 1 );
+                    }
+                }
+            }
+            CHECK( sm->active_fields.size() == on_tiles );
+            fields += on_tiles;
+        }
+    }
+    CHECK( fields > 0 );
+}
@@ -1,6 +1,7 @@
 #include "catch/catch.hpp"
 
 #include <cmath>
+#include <cstdint>
 #include <fstream>
 #include <sstream>
 #include <string>
@@ -14,6 +15,7 @@
 #include "game.h"
 #include "map.h"
 #include "map_helpers.h"
+#include "mapdata.h"
 #include "monster.h"
 #include "options_helpers.h"
 #include "options.h"
@@ -354,3 +356,23 @@ TEST_CASE( "monster_move_through_vehicle_holes" )
     CHECK( m2 == nullptr );
 
 }
+
+TEST_CASE( "monsters_are_pushed_out_of_walls_built_on_them", "[monster]" )
+{
+    clear_all_state();
+    put_player_underground();
+    map &here = get_map();
+    const tripoint walled( 60, 60, 0 );
+    for( const tripoint &p : here.points_in_radius( walled, 4 ) ) {
+        here.ter_set( p, t_floor );
+    }
+    monster &zombie = spawn_test_monster( "mon_zombie", walled );
+    spawn_test_monster( "mon_zombie", walled + tripoint( 3, 0, 0 ) );
+
+    const int64_t passability = here.get_passability_generation();
+    here.ter_set( walled, t_wall );
+    CHECK( here.get_passability_generation() > passability );
+
+    g->monmove();
+    CHECK( ( zombie.is_dead() || zombie.pos() != walled ) );
+}
@@ -2,8 +2,10 @@
 
 #include <memory>
 
+#include "avatar.h"
 #include "calendar.h"
 #include "game.h"
+#include "item.h"
 #include "map.h"
 #include "map_helpers.h"
 #include "mapdata.h"
@@ -101,3 +103,185 @@ TEST_CASE( "monsters_dont_see_through_vehicle_holes", "[vision]" )
     CHECK( !outside.sees( inside ) );
 
 }
+
+TEST_CASE( "monster_sight_is_cached_until_something_changes", "[vision]" )
+{
+    clear_all_state();
+    calendar::turn = midday;
+    put_player_underground();
+    map &here = get_map();
+    here.build_map_cache( 0 );
+
+    monster &watcher = spawn_and_clear( { 30, 30, 0 }, true );
+    monster &target = spawn_and_clear( { 30, 34, 0 }, true );
+
+    Creature::reset_sight_cache_stats();
+    CHECK( watcher.sees( target ) );
+    CHECK( watcher.sees( target ) );
+    CHECK( Creature::get_sight_cache_stats().hits == 1 );
+    CHECK( Creature::get_sight_cache_stats().misses == 1 );
+
+    // Terrain changes invalidate the cache
+    // The player isn't around to see it, so the map's own line cache must be dropped by hand
+    here.ter_set( { 30, 32, 0 }, t_wall );
+    here.set_seen_cache_dirty( 0 );
+    here.build_map_cache( 0 );
+    CHECK_FALSE( watcher.sees( target ) );
+
+    // Changes on submaps the line of sight doesn't cross keep the result
+    Creature::reset_sight_cache_stats();
+    here.ter_set( { 90, 90, 0 }, t_wall );
+    CHECK_FALSE( watcher.sees( target ) );
+    CHECK( Creature::get_sight_cache_stats().hits == 1 );
+
+    // Moving around it doesn't need an invalidation
+    target.setpos( { 31, 34, 0 } );
+    CHECK( watcher.sees( target ) );
+    target.setpos( { 30, 34, 0 } );
+    CHECK_FALSE( watcher.sees( target ) );
+
+    // Every turn starts from scratch
+    here.ter_set( { 30, 32, 0 }, t_floor );
+    here.set_seen_cache_dirty( 0 );
+    here.build_map_cache( 0 );
+    CHECK( watcher.sees( target ) );
+    calendar::turn += 1_turns;
+    Creature::reset_sight_cache_stats();
+    CHECK( watcher.sees( target ) );
+    CHECK( Creature::get_sight_cache_stats().misses == 1 );
+}
+
+TEST_CASE( "precomputed_monster_sight_matches_serial_checks", "[vision]" )
+{
+    clear_all_state();
+    calendar::turn = midday;
+    put_player_underground();
+    map &here = get_map();
+    for( int y = 20; y < 40; y++ ) {
+        here.ter_set( { 35, y, 0 }, t_wall );
+    }
+    here.build_map_cache( 0 );
+
+    std::vector<monster *> zombies;
+    for( int i = 0; i < 40; i++ ) {
+        zombies.push_back( &spawn_and_clear( { 28 + ( i % 5 ) * 3, 22 + ( i / 5 ) * 2, 0 }, true ) );
+    }
+    std::vector<std::pair<const Creature *, const Creature *>> pairs;
+    for( const monster *observer : zombies ) {
+        for( const monster *target : zombies ) {
+            pairs.emplace_back( observer, target );
+        }
+    }
+
+    Creature::invalidate_sight_cache();
+    std::vector<bool> serial;
+    for( const auto &pair : pairs ) {
+        serial.push_back( pair.first->sees( *pair.second ) );
+    }
+
+    Creature::invalidate_sight_cache();
+    Creature::precompute_sight( pairs );
+    Creature::reset_sight_cache_stats();
+    for( size_t i = 0; i < pairs.size(); i++ ) {
+        CHECK( pairs[i].first->sees( *pairs[i].second ) == serial[i] );
+    }
+    CHECK( Creature::get_sight_cache_stats().misses == 0 );
+}
+
+TEST_CASE( "monster_sight_cache_follows_optical_cloak", "[vision]" )
+{
+    clear_all_state();
+    calendar::turn = midday;
+    map &here = get_map();
+    avatar &you = get_avatar();
+    here.ter_set( { 30, 30, 0 }, t_floor );
+    you.setpos( { 30, 30, 0 } );
+    here.build_map_cache( 0 );
+    monster &watcher = spawn_and_clear( { 30, 34, 0 }, true );
+
+    you.wear_item( item::spawn( "optical_cloak" ), false );
+    you.i_add( item::spawn( "UPS_off", calendar::turn, 500 ) );
+    item *cloak = nullptr;
+    for( item *it : you.worn ) {
+        if( it->typeId() == itype_id( "optical_cloak" ) ) {
+            cloak = it;
+        }
+    }
+    REQUIRE( cloak != nullptr );
+
+    // All within one turn, so only the toggle itself can invalidate the cache
+    REQUIRE( watcher.sees( you ) );
+    you.invoke_item( cloak );
+    REQUIRE( you.is_invisible() );
+    CHECK_FALSE( watcher.sees( you ) );
+    you.invoke_item( cloak );
+    REQUIRE_FALSE( you.is_invisible() );
+    CHECK( watcher.sees( you ) );
+}
+
+TEST_CASE( "monster_sight_cache_survives_door_changes_elsewhere", "[vision]" )
+{
+    clear_all_state();
+    calendar::turn = midday;
+    put_player_underground();
+    map &here = get_map();
+    here.build_map_cache( 0 );
+
+    // A horde in one corner of the map while doors open and close across it
+    std::vector<monster *> zombies;
+    for( int i = 0; i < 40; i++ ) {
+        zombies.push_back( &spawn_and_clear( { 26 + ( i % 8 ) * 2, 26 + ( i / 8 ) * 2, 0 }, true ) );
+    }
+    const std::vector<tripoint> doors = { { 80, 40, 0 }, { 100, 100, 0 }, { 40, 110, 0 }, { 36, 36, 0 } };
+
+    Creature::invalidate_sight_cache();
+    Creature::reset_sight_cache_stats();
+    for( int round = 0; round < 4; round++ ) {
+        for( size_t i = 0; i < zombies.size(); i++ ) {
+            // Every monster's turn changes a door somewhere, once per round next to the horde
+            const tripoint &door = i == 0 ? doors.back() : doors[i % ( doors.size() - 1 )];
+            here.ter_set( door, here.ter( door ) == t_door_c ? t_door_o : t_door_c );
+            for( const monster *target : zombies ) {
+                zombies[i]->sees( *target );
+            }
+        }
+    }
+    const Creature::sight_cache_stats &stats = Creature::get_sight_cache_stats();
+    const double hit_rate = static_cast<double>( stats.hits ) / ( stats.hits + stats.misses );
+    CAPTURE( stats.hits, stats.misses, stats.invalidations, hit_rate );
+    CHECK( hit_rate > 0.5 );
+}
+
+TEST_CASE( "monster_plan_only_checks_precomputed_sight", "[vision]" )
+{
+    clear_all_state();
+    calendar::turn = midday;
+    map &here = get_map();
+    avatar &you = get_avatar();
+    here.ter_set( { 30, 30, 0 }, t_floor );
+    you.setpos( { 30, 30, 0 } );
+
+    std::vector<monster *> zombies;
+    for( int i = 0; i < 12; i++ ) {
+        zombies.push_back( &spawn_and_clear( { 24 + ( i % 4 ) * 4, 25 + ( i / 4 ) * 5, 0 }, true ) );
+    }
+    here.build_map_cache( 0 );
+
+    std::vector<std::pair<const Creature *, const Creature *>> pairs;
+    for( const monster *critter : zombies ) {
+        for( const Creature *target : critter->plan_sight_targets() ) {
+            pairs.emplace_back( critter, target );
+        }
+    }
+    // Zombies only go after the player, not after each other
+    CHECK( pairs.size() == zombies.size() );
+
+    Creature::invalidate_sight_cache();
+    Creature::precompute_sight( pairs );
+    Creature::reset_sight_cache_stats();
+    for( monster *critter : zombies ) {
+        critter->plan();
+    }
+    CHECK( Creature::get_sight_cache_stats().hits > 0 );
+    CHECK( Creature::get_sight_cache_stats().misses == 0 );
+}
@@ -0,0 +1,454 @@
+#include "catch/catch.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <set>
+#include <vector>
+
+#include "game_constants.h"
+#include "hierarchical_pathfinding.h"
+#include "legacy_pathfinding.h"
+#include "line.h"
+#include "map.h"
+#include "mapdata.h"
+#include "pathfinding.h"
+#include "point.h"
+#include "simple_pathfinding.h"
+#include "state_helpers.h"
+#include "string_formatter.h"
+
+static bool route_crosses( const std::vector<tripoint> &route, const ter_id &ter )
+{
+    const map &here = get_map();
+    for( const tripoint &p : route ) {
+        if( here.ter( p ) == ter ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+TEST_CASE( "pathfinding_d_maps_are_shared_and_repaired", "[pathfinding]" )
+{
+    clear_all_state();
+    Pathfinding::clear_d_maps();
+    map &here = get_map();
+
+    const tripoint target( 70, 60, 0 );
+    const PathfindingSettings settings;
+
+    const std::vector<tripoint> first = Pathfinding::route( tripoint( 60, 60, 0 ), target, settings );
+    REQUIRE( first.size() == 11 );
+
+    // The rest of the horde chasing the same target reuses its d_map
+    for( int y = 55; y <= 65; y++ ) {
+        CHECK_FALSE( Pathfinding::route( tripoint( 58, y, 0 ), target, settings ).empty() );
+    }
+    CHECK( Pathfinding::d_map_count() == 1 );
+
+    // Wall in the middle appears after the d_map was built
+    for( int y = 50; y <= 70; y++ ) {
+        here.ter_set( tripoint( 65, y, 0 ), t_wall );
+    }
+    const std::vector<tripoint> around = Pathfinding::route( tripoint( 60, 60, 0 ), target, settings );
+    REQUIRE_FALSE( around.empty() );
+    CHECK( around.size() > first.size() );
+    CHECK_FALSE( route_crosses( around, t_wall ) );
+
+    // And is gone again
+    for( int y = 50; y <= 70; y++ ) {
+        here.ter_set( tripoint( 65, y, 0 ), t_floor );
+    }
+    CHECK( Pathfinding::route( tripoint( 60, 60, 0 ), target, settings ).size() == first.size() );
+    CHECK( Pathfinding::d_map_count() == 1 );
+
+    Pathfinding::clear_d_maps();
+}
+
+TEST_CASE( "pathfinding_d_maps_repair_tiles_the_last_search_skipped", "[pathfinding]" )
+{
+    clear_all_state();
+    Pathfinding::clear_d_maps();
+    map &here = get_map();
+
+    const tripoint target( 70, 60, 0 );
+    const PathfindingSettings settings;
+    const std::vector<tripoint> first = Pathfinding::route( tripoint( 60, 60, 0 ), target, settings );
+    REQUIRE( first.size() == 11 );
+
+    // A narrow search near the target resets the tile states but keeps the g-values further out
+    RouteSettings narrow;
+    narrow.search_radius_coeff = 1.5;
+    narrow.search_cone_angle = 45.0;
+    REQUIRE_FALSE( Pathfinding::route( tripoint( 68, 60, 0 ), target, settings, narrow ).empty() );
+    REQUIRE( Pathfinding::d_map_count() == 1 );
+
+    for( int y = 50; y <= 70; y++ ) {
+        here.ter_set( tripoint( 65, y, 0 ), t_wall );
+    }
+    const std::vector<tripoint> around = Pathfinding::route( tripoint( 60, 60, 0 ), target, settings );
+    REQUIRE_FALSE( around.empty() );
+    CHECK_FALSE( route_crosses( around, t_wall ) );
+
+    Pathfinding::clear_d_maps();
+}
+
+static void check_walkable( const std::vector<tripoint> &route, const tripoint &from,
+                            const tripoint &to )
+{
+    REQUIRE_FALSE( route.empty() );
+    CHECK( route.front() == from );
+    CHECK( route.back() == to );
+    for( size_t i = 1; i < route.size(); i++ ) {
+        CHECK( square_dist( route[i - 1], route[i] ) == 1 );
+    }
+    CHECK_FALSE( route_crosses( route, t_wall ) );
+}
+
+TEST_CASE( "hierarchical_pathfinding_follows_terrain_changes", "[pathfinding]" )
+{
+    clear_all_state();
+    HierarchicalPathfinding::clear();
+    map &here = get_map();
+
+    const tripoint from( 20, 60, 0 );
+    const tripoint to( 110, 60, 0 );
+    const PathfindingSettings settings;
+
+    // A wall across the whole map with a single gap
+    const auto build_wall = [&]( const int gap_y ) {
+        for( int y = 0; y < MAPSIZE_Y; y++ ) {
+            here.ter_set( tripoint( 65, y, 0 ), y == gap_y ? t_floor : t_wall );
+        }
+    };
+
+    build_wall( 30 );
+    const std::vector<tripoint> through_first = HierarchicalPathfinding::route( from, to, settings );
+    check_walkable( through_first, from, to );
+    CHECK( std::ranges::find( through_first, tripoint( 65, 30, 0 ) ) != through_first.end() );
+    // Planning on submaps costs a few detours at most
+    const std::vector<tripoint> exact = Pathfinding::route( from, to, settings );
+    REQUIRE_FALSE( exact.empty() );
+    CHECK( through_first.size() <= exact.size() + 2 * SEEX );
+
+    // Only the submaps around the wall are recomputed
+    build_wall( 100 );
+    const std::vector<tripoint> through_second = HierarchicalPathfinding::route( from, to, settings );
+    check_walkable( through_second, from, to );
+    CHECK( std::ranges::find( through_second, tripoint( 65, 100, 0 ) ) != through_second.end() );
+
+    build_wall( -1 );
+    CHECK( HierarchicalPathfinding::route( from, to, settings ).empty() );
+
+    HierarchicalPathfinding::clear();
+    Pathfinding::clear_d_maps();
+}
+
+TEST_CASE( "hierarchical_pathfinding_respects_avoided_tiles", "[pathfinding]" )
+{
+    clear_all_state();
+    HierarchicalPathfinding::clear();
+
+    const tripoint from( 20, 60, 0 );
+    const tripoint to( 110, 60, 0 );
+    const PathfindingSettings settings;
+
+    // Like the creatures an NPC walks around, the destination itself included
+    std::set<tripoint> avoid;
+    for( int x = 21; x <= 110; x++ ) {
+        avoid.emplace( x, 60, 0 );
+    }
+    const std::vector<tripoint> route = HierarchicalPathfinding::route( from, to, settings,
+                                        std::nullopt, avoid );
+    check_walkable( route, from, to );
+    for( size_t i = 0; i + 1 < route.size(); i++ ) {
+        CAPTURE( route[i] );
+        CHECK_FALSE( avoid.contains( route[i] ) );
+    }
+
+    HierarchicalPathfinding::clear();
+    Pathfinding::clear_d_maps();
+}
+
+// Pathfinding benchmarks: canned maps and replays of the queries a turn of play makes on them.
+
+struct movement_class {
+    const char *name;
+    PathfindingSettings settings;
+    pathfinding_settings legacy;
+    bool flies;
+};
+
+struct recorded_query {
+    tripoint from;
+    tripoint to;
+    const movement_class *mc;
+};
+
+static movement_class zombie_class()
+{
+    movement_class ret{ "zombie", {}, pathfinding_settings( 10, 120, 1000, 0, false, false, true, false, false ), false };
+    ret.settings.bash_strength_val = 10;
+    ret.settings.move_cost_coeff = 0.01;
+    ret.settings.can_climb_stairs = true;
+    return ret;
+}
+
+static movement_class npc_class()
+{
+    movement_class ret{ "npc", {}, pathfinding_settings( 5, 120, 1000, 5, true, true, true, false, true ), false };
+    ret.settings.bash_strength_val = 5;
+    ret.settings.door_open_cost = 2.0;
+    ret.settings.climb_cost = 5.0;
+    ret.settings.trap_cost = INFINITY;
+    ret.settings.sharp_terrain_cost = INFINITY;
+    ret.settings.can_climb_stairs = true;
+    return ret;
+}
+
+static movement_class flier_class()
+{
+    movement_class ret{ "flier", {}, pathfinding_settings(), true };
+    ret.settings.move_cost_coeff = 0.01;
+    ret.settings.can_fly = true;
+    return ret;
+}
+
+// Deterministic spread of points so replays are comparable between runs
+static point scatter( const int i, const int lo, const int hi )
+{
+    const unsigned h = static_cast<unsigned>( i + 1 ) * 2654435761u;
+    const int span = hi - lo;
+    return point( lo + static_cast<int>( h % span ), lo + static_cast<int>( ( h >> 16 ) % span ) );
+}
+
+static void fill_level( const int z, const ter_id &ter )
+{
+    map &here = get_map();
+    for( int y = 0; y < MAPSIZE_Y; y++ ) {
+        for( int x = 0; x < MAPSIZE_X; x++ ) {
+            here.ter_set( tripoint( x, y, z ), ter );
+        }
+    }
+}
+
+static void finish_map( const int zmin, const int zmax )
+{
+    map &here = get_map();
+    for( int z = zmin; z <= zmax; z++ ) {
+        here.invalidate_map_cache( z );
+        here.build_map_cache( z, true );
+    }
+    Pathfinding::mark_dirty_z_cache();
+    Pathfinding::clear_d_maps();
+    HierarchicalPathfinding::clear();
+}
+
+// Walled buildings with a door on each side, in a grid of streets
+static void build_city_block()
+{
+    map &here = get_map();
+    fill_level( 0, t_pavement );
+    for( int by = 6; by + 20 < MAPSIZE_Y; by += 26 ) {
+        for( int bx = 6; bx + 20 < MAPSIZE_X; bx += 26 ) {
+            for( int y = by; y < by + 20; y++ ) {
+                for( int x = bx; x < bx + 20; x++ ) {
+                    const bool is_wall = x == bx || x == bx + 19 || y == by || y == by + 19;
+                    const bool is_door = ( x == bx + 10 || y == by + 10 ) && is_wall;
+                    here.ter_set( tripoint( x, y, 0 ), is_door ? t_door_c : is_wall ? t_wall : t_floor );
+                }
+            }
+        }
+    }
+    finish_map( 0, 0 );
+}
+
+// Rooms on several levels below ground, joined by stairs far from each other
+static constexpr int lab_levels = 4;
+
+static point lab_stairs( const int z )
+{
+    return z % 2 == 0 ? point( 20, 110 ) : point( 110, 20 );
+}
+
+static void build_lab()
+{
+    map &here = get_map();
+    for( int z = -lab_levels; z < 0; z++ ) {
+        fill_level( z, t_rock );
+        for( int y = 8; y < MAPSIZE_Y - 8; y++ ) {
+            for( int x = 8; x < MAPSIZE_X - 8; x++ ) {
+                const bool is_wall = ( x % 16 == 0 && y % 16 != 8 ) || ( y % 16 == 0 && x % 16 != 8 );
+                here.ter_set( tripoint( x, y, z ), is_wall ? t_wall : t_floor );
+            }
+        }
+    }
+    fill_level( 0, t_grass );
+    for( int z = 0; z > -lab_levels; z-- ) {
+        here.ter_set( tripoint( lab_stairs( z ), z ), t_stairs_down );
+        here.ter_set( tripoint( lab_stairs( z ), z - 1 ), t_stairs_up );
+    }
+    finish_map( -lab_levels, 0 );
+}
+
+// Grass and trees under open air
+static void build_open_field()
+{
+    map &here = get_map();
+    fill_level( 0, t_grass );
+    for( int i = 0; i < 400; i++ ) {
+        here.ter_set( tripoint( scatter( i, 0, MAPSIZE_X ), 0 ), t_tree );
+    }
+    for( int z = 1; z <= 3; z++ ) {
+        fill_level( z, t_open_air );
+    }
+    finish_map( 0, 3 );
+}
+
+// A horde closing in on one target and a few long walks
+static std::vector<recorded_query> record_queries( const movement_class &horde,
+        const movement_class &walkers, const tripoint &target, const int horde_z, const int walk_z )
+{
+    std::vector<recorded_query> ret;
+    for( int i = 0; i < 60; i++ ) {
+        const point from = scatter( i, 10, MAPSIZE_X - 10 );
+        ret.push_back( { tripoint( from, horde_z ), target, &horde } );
+    }
+    for( int i = 0; i < 12; i++ ) {
+        const point from = scatter( 1000 + i, 10, MAPSIZE_X - 10 );
+        const point to = scatter( 2000 + i, 10, MAPSIZE_X - 10 );
+        ret.push_back( { tripoint( from, walk_z ), tripoint( to, walk_z ), &walkers } );
+    }
+    return ret;
+}
+
+// One turn worth of queries: d_maps are only shared within a turn
+static int replay( const std::vector<recorded_query> &queries )
+{
+    Pathfinding::clear_d_maps();
+    int found = 0;
+    for( const recorded_query &q : queries ) {
+        found += !Pathfinding::route( q.from, q.to, q.mc->settings ).empty();
+    }
+    return found;
+}
+
+static int replay_hierarchical( const std::vector<recorded_query> &queries )
+{
+    Pathfinding::clear_d_maps();
+    int found = 0;
+    for( const recorded_query &q : queries ) {
+        found += !HierarchicalPathfinding::route( q.from, q.to, q.mc->settings ).empty();
+    }
+    return found;
+}
+
+static int replay_legacy( const std::vector<recorded_query> &queries )
+{
+    const map &here = get_map();
+    int found = 0;
+    for( const recorded_query &q : queries ) {
+        if( !q.mc->flies ) {
+            found += !here.route( q.from, q.to, q.mc->legacy ).empty();
+        }
+    }
+    return found;
+}
+
+static void report( const char *scenario, const std::vector<recorded_query> &queries )
+{
+    Pathfinding::reset_stats();
+    const auto start = std::chrono::steady_clock::now();
+    const int found = replay( queries );
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    const PathfindingStats &stats = Pathfinding::get_stats();
+    const uint64_t searches = stats.d_map_hits + stats.d_map_misses;
+    cata_printf( "%s: %d queries, %d routes found, %.0f queries/s, %.1f nodes expanded per query, "
+                 "%.1f%% d_map hits\n", scenario, queries.size(), found,
+                 queries.size() / std::max( elapsed.count(), 1e-9 ),
+                 static_cast<double>( stats.nodes_expanded ) / queries.size(),
+                 searches != 0 ? 100.0 * stats.d_map_hits / searches : 0.0 );
+}
+
+TEST_CASE( "pathfinding_benchmark_city_block", "[.][pathfinding][benchmark]" )
+{
+    clear_all_state();
+    build_city_block();
+    const movement_class zombie = zombie_class();
+    const movement_class npc = npc_class();
+    const std::vector<recorded_query> queries = record_queries( zombie, npc, tripoint( 70, 70, 0 ), 0,
+            0 );
+    report( "city block", queries );
+
+    BENCHMARK( "Pathfinding::route" ) {
+        return replay( queries );
+    };
+    BENCHMARK( "HierarchicalPathfinding::route" ) {
+        return replay_hierarchical( queries );
+    };
+    BENCHMARK( "map::route" ) {
+        return replay_legacy( queries );
+    };
+    BENCHMARK( "pf::greedy_path" ) {
+        const map &here = get_map();
+        size_t steps = 0;
+        for( const recorded_query &q : queries ) {
+            const pf::two_node_scoring_fn<point> scorer = [&]( pf::directed_node<point> cur,
+            std::optional<pf::directed_node<point>> ) {
+                const int cost = here.move_cost( tripoint( cur.pos, 0 ) );
+                return cost > 0 ? pf::node_score( cost, 2 * manhattan_dist( cur.pos, q.to.xy() ) ) :
+                       pf::node_score::rejected;
+            };
+            steps += pf::greedy_path( q.from.xy(), q.to.xy(), point( MAPSIZE_X - 1, MAPSIZE_Y - 1 ),
+                                      scorer ).nodes.size();
+        }
+        return steps;
+    };
+    clear_all_state();
+}
+
+TEST_CASE( "pathfinding_benchmark_lab", "[.][pathfinding][benchmark]" )
+{
+    clear_all_state();
+    build_lab();
+    const movement_class zombie = zombie_class();
+    const movement_class npc = npc_class();
+    // Zombies on the bottom level, people walking in from the surface
+    std::vector<recorded_query> queries = record_queries( zombie, npc,
+                                          tripoint( 72, 72, -lab_levels ), -lab_levels, -2 );
+    for( int i = 0; i < 12; i++ ) {
+        const tripoint to( scatter( 3000 + i, 10, MAPSIZE_X - 10 ), -lab_levels );
+        queries.push_back( { tripoint( 60, 60, 0 ), to, &npc } );
+    }
+    report( "lab", queries );
+
+    BENCHMARK( "Pathfinding::route" ) {
+        return replay( queries );
+    };
+    BENCHMARK( "map::route" ) {
+        return replay_legacy( queries );
+    };
+    clear_all_state();
+}
+
+TEST_CASE( "pathfinding_benchmark_open_field", "[.][pathfinding][benchmark]" )
+{
+    clear_all_state();
+    build_open_field();
+    const movement_class flier = flier_class();
+    const movement_class zombie = zombie_class();
+    // Fliers coming down on a target on the ground, zombies walking around the trees
+    std::vector<recorded_query> queries = record_queries( flier, zombie, tripoint( 66, 66, 0 ), 2,
+                                          0 );
+    report( "open field", queries );
+
+    BENCHMARK( "Pathfinding::route" ) {
+        return replay( queries );
+    };
+    BENCHMARK( "map::route" ) {
+        return replay_legacy( queries );
+    };
+    clear_all_state();
+}
@@ -1,16 +1,20 @@
 #include "catch/catch.hpp"
 
 #include <memory>
+#include <vector>
 
 #include "calendar.h"
 #include "enums.h"
+#include "flag.h"
 #include "item.h"
 #include "map.h"
 #include "map_helpers.h"
+#include "mtype.h"
 #include "game.h" // Just for get_convection_temperature(), TODO: Remove
 #include "point.h"
 #include "units_temperature.h"
 #include "weather.h"
+#include "weather_gen.h"
 
 static const furn_str_id f_atomic_freezer( "f_atomic_freezer" );
 
@@ -204,3 +208,167 @@ TEST_CASE( "Items don't rot away on map load if in a freezer" )
     auto normal_stack_after = m.i_at( normal_pnt );
     REQUIRE( normal_stack_after.empty() );
 }
+
+namespace
+{
+
+struct rot_result {
+    time_duration rot;
+    bool rotten_away;
+};
+
+// The hour by hour catch up items left out of the reality bubble used to do, item by item
+rot_result hourly_rot_catch_up( const item &it, bool seals, const tripoint &pos,
+                                temperature_flag flag, const weather_manager &weather,
+                                time_point last_rot_check )
+{
+    const tripoint_abs_ms location( get_map().getabs( pos ) );
+    const weather_generator &generator = weather.get_cur_weather_gen();
+    const float factor = it.is_corpse() && it.has_flag( flag_FIELD_DRESS ) ? 0.75f : 1.0f;
+    const time_duration shelf_life = it.get_shelf_life();
+    const auto add_rot = [&]( time_duration & rot, const time_duration & time_delta,
+    units::temperature temp ) {
+        if( it.is_corpse() || !( rot / shelf_life > 2.0 ) ) {
+            rot += factor * time_delta / 1_hours * get_hourly_rotpoints_at_temp( temp ) * 1_turns;
+        }
+    };
+    const auto rotten_away = [&]( const time_duration & rot ) {
+        if( it.is_corpse() && !it.can_revive() ) {
+            return rot > 10_days;
+        }
+        return it.is_food() && rot / shelf_life > 2.0;
+    };
+
+    const time_point now = calendar::turn;
+    time_duration rot = it.get_rot();
+    time_point time = last_rot_check;
+    while( now - time > 1_hours ) {
+        const time_duration time_delta = std::min( 1_hours, now - 1_hours - time );
+        time += time_delta;
+        units::temperature temp = generator.get_weather_temperature( location, time, calendar::config,
+                                  g->get_seed() );
+        if( flag == temperature_flag::TEMP_FREEZER ) {
+            temp = std::min( temp, temperatures::freezer );
+        }
+        add_rot( rot, time_delta, temp );
+        if( rotten_away( rot ) && !seals ) {
+            return { rot, true };
+        }
+    }
+    if( now - time > 10_minutes ) {
+        units::temperature temp = weather.get_temperature( pos );
+        if( flag == temperature_flag::TEMP_FREEZER ) {
+            temp = std::min( temp, temperatures::freezer );
+        }
+        add_rot( rot, now - time, temp );
+        if( rotten_away( rot ) && !seals ) {
+            return { rot, true };
+        }
+    }
+    return { rot, false };
+}
+
+} // namespace
+
+TEST_CASE( "Catching up on rot matches processing it hour by hour", "[rot]" )
+{
+    static const mtype_id mon_chicken( "mon_chicken" );
+    static const mtype_id mon_zombie( "mon_zombie" );
+
+    weather_manager weather;
+    set_map_temperature( weather, 18_c );
+    ensure_no_temperature_mods( tripoint_zero );
+
+    if( calendar::turn <= calendar::start_of_cataclysm ) {
+        calendar::turn = calendar::start_of_cataclysm + 1_minutes;
+    }
+    const time_point start = calendar::turn;
+
+    const auto make_food = []( double relative_rot ) {
+        detached_ptr<item> food = item::spawn( "meat_cooked" );
+        food->set_relative_rot( relative_rot );
+        return food;
+    };
+    const auto make_corpse = []( const mtype_id & mon, bool field_dressed, time_duration rot ) {
+        detached_ptr<item> corpse = item::make_corpse( mon, calendar::turn );
+        if( field_dressed ) {
+            corpse->set_flag( flag_FIELD_DRESS );
+        }
+        corpse->mod_rot( rot );
+        return corpse;
+    };
+
+    for( const time_duration &absence : {
+             1_hours + 5_minutes, 1_days + 17_minutes, 5_days + 3_hours, 23_days + 40_minutes
+         } ) {
+        for( temperature_flag flag : {
+                 temperature_flag::TEMP_NORMAL, temperature_flag::TEMP_FREEZER
+             } ) {
+            for( bool seals : { false, true } ) {
+                calendar::turn = start;
+                std::vector<detached_ptr<item>> items;
+                items.push_back( make_food( 0.0 ) );
+                items.push_back( make_food( 1.2 ) );
+                items.push_back( make_food( 1.99 ) );
+                items.push_back( make_food( 2.5 ) );
+                items.push_back( make_corpse( mon_chicken, false, 0_turns ) );
+                items.push_back( make_corpse( mon_chicken, true, 0_turns ) );
+                items.push_back( make_corpse( mon_chicken, false, 9_days ) );
+                items.push_back( make_corpse( mon_zombie, false, 9_days ) );
+
+                calendar::turn = start + absence;
+                for( size_t i = 0; i < items.size(); i++ ) {
+                    const rot_result expected = hourly_rot_catch_up( *items[i], seals, tripoint_zero, flag,
+                                                weather, start );
+                    detached_ptr<item> it = item::process_rot( std::move( items[i] ), seals, tripoint_zero,
+                                            nullptr, flag, weather );
+                    CAPTURE( to_minutes<int>( absence ), static_cast<int>( flag ), seals, i );
+                    CHECK( !it == expected.rotten_away );
+                    if( it ) {
+                        CHECK( to_turns<int>( it->get_rot() ) == to_turns<int>( expected.rot ) );
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE( "rot_catch_up_benchmark", "[.][rot][benchmark]" )
+{
+    weather_manager weather;
+    set_map_temperature( weather, 18_c );
+    if( calendar::turn <= calendar::start_of_cataclysm ) {
+        calendar::turn = calendar::start_of_cataclysm + 1_minutes;
+    }
+    const time_point start = calendar::turn;
+
+    // A well stocked freezer and pantry left alone for a season
+    const auto stock = []() {
+        std::vector<detached_ptr<item>> items;
+        for( int i = 0; i < 500; i++ ) {
+            items.push_back( item::spawn( i % 2 == 0 ? "meat_cooked" : "offal_canned" ) );
+        }
+        return items;
+    };
+
+    // Includes spawning the items, which doesn't depend on the time they were left alone
+    BENCHMARK( "catch up on 90 days of rot" ) {
+        calendar::turn = start;
+        std::vector<detached_ptr<item>> freezer = stock();
+        std::vector<detached_ptr<item>> pantry = stock();
+        calendar::turn = start + 90_days;
+        int kept = 0;
+        for( detached_ptr<item> &it : freezer ) {
+            it = item::process_rot( std::move( it ), false, tripoint_zero, nullptr,
+                                    temperature_flag::TEMP_FREEZER, weather );
+            kept += !!it;
+        }
+        for( detached_ptr<item> &it : pantry ) {
+            it = item::process_rot( std::move( it ), true, tripoint_zero, nullptr,
+                                    temperature_flag::TEMP_NORMAL, weather );
+            kept += !!it;
+        }
+        return kept;
+    };
+    calendar::turn = start;
+}
@@ -8,6 +8,8 @@
 
 void old_scent_map_update( const tripoint &center, map &m,
                            std::array<std::array<int, MAPSIZE_Y>, MAPSIZE_X> &grscent );
+void scalar_scent_map_update( const tripoint &center, map &m,
+                              std::array<std::array<int, MAPSIZE_Y>, MAPSIZE_X> &grscent );
 
 static constexpr int SCENT_RADIUS = 40;
 void old_scent_map_update( const tripoint &center, map &m,
@@ -123,6 +125,172 @@ void old_scent_map_update( const tripoint &center, map &m,
     }
 }
 
+// scent_map::update before the diffusion loops were reordered for vectorization
+void scalar_scent_map_update( const tripoint &center, map &m,
+                              std::array<std::array<int, MAPSIZE_Y>, MAPSIZE_X> &grscent )
+{
+    std::array<std::array<char, MAPSIZE_Y>, MAPSIZE_X> scent_transfer;
+
+    std::array < std::array < int, 3 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > new_scent;
+    std::array < std::array < int, 3 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > sum_3_scent_y;
+    std::array < std::array < char, 3 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > squares_used_y;
+
+    diagonal_blocks( &blocked_cache )[MAPSIZE_X][MAPSIZE_Y] = m.access_cache(
+                center.z ).vehicle_obstructed_cache;
+
+    const int scentmap_minx = center.x - SCENT_RADIUS;
+    const int scentmap_maxx = center.x + SCENT_RADIUS;
+    const int scentmap_miny = center.y - SCENT_RADIUS;
+    const int scentmap_maxy = center.y + SCENT_RADIUS;
+
+    m.scent_blockers( scent_transfer, point( scentmap_minx - 1, scentmap_miny - 1 ),
+                      point( scentmap_maxx + 1, scentmap_maxy + 1 ) );
+
+    for( int x = 0; x < SCENT_RADIUS * 2 + 3; ++x ) {
+        for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
+            point abs( x + scentmap_minx - 1, y + scentmap_miny );
+            sum_3_scent_y[y][x] = 0;
+            squares_used_y[y][x] = 0;
+            for( int i = abs.y - 1; i <= abs.y + 1; ++i ) {
+                sum_3_scent_y[y][x] += scent_transfer[abs.x][i] * grscent[abs.x][i];
+                squares_used_y[y][x] += scent_transfer[abs.x][i];
+            }
+        }
+    }
+
+    for( int x = 1; x < SCENT_RADIUS * 2 + 2; ++x ) {
+        for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
+            const point abs( x + scentmap_minx - 1, y + scentmap_miny );
+
+            int squares_used = squares_used_y[y][x - 1] + squares_used_y[y][x] + squares_used_y[y][x + 1];
+            int total = sum_3_scent_y[y][x - 1] + sum_3_scent_y[y][x] + sum_3_scent_y[y][x + 1];
+
+            if( blocked_cache[abs.x][abs.y].nw && scent_transfer[abs.x + 1][abs.y + 1] == 5 ) {
+                squares_used -= 4;
+                total -= 4 * grscent[abs.x + 1][abs.y + 1];
+            }
+            if( blocked_cache[abs.x][abs.y].ne && scent_transfer[abs.x - 1][abs.y + 1] == 5 ) {
+                squares_used -= 4;
+                total -= 4 * grscent[abs.x - 1][abs.y + 1];
+            }
+            if( blocked_cache[abs.x - 1][abs.y - 1].nw && scent_transfer[abs.x - 1][abs.y - 1] == 5 ) {
+                squares_used -= 4;
+                total -= 4 * grscent[abs.x - 1][abs.y - 1];
+            }
+            if( blocked_cache[abs.x + 1][abs.y - 1].ne && scent_transfer[abs.x + 1][abs.y - 1] == 5 ) {
+                squares_used -= 4;
+                total -= 4 * grscent[abs.x + 1][abs.y - 1];
+            }
+
+            int temp_scent = grscent[abs.x][abs.y] * ( 250 - squares_used * scent_transfer[abs.x][abs.y] );
+            temp_scent -= grscent[abs.x][abs.y] * scent_transfer[abs.x][abs.y] * ( 45 - squares_used ) / 5;
+
+            new_scent[y][x] = ( temp_scent + total * scent_transfer[abs.x][abs.y] ) / 250;
+        }
+    }
+    for( int x = 1; x < SCENT_RADIUS * 2 + 2; ++x ) {
+        for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
+            grscent[x + scentmap_minx - 1 ][y + scentmap_miny] = new_scent[y][x];
+        }
+    }
+}
+
+// Walls, half walls and scent-reducing furniture around a strong scent source
+static void set_up_scent_scenario( const tripoint &origin )
+{
+    clear_all_state();
+    g->place_player( origin );
+
+    map &here = get_map();
+    here.ter_set( origin + tripoint_south_west, t_brick_wall );
+    here.ter_set( origin + tripoint_west, t_brick_wall );
+    here.ter_set( origin + tripoint_north, t_rock_wall_half );
+    for( int i = -3; i <= 3; i++ ) {
+        here.furn_set( origin + tripoint( i, 4, 0 ), furn_str_id( "f_pillow_fort" ) );
+    }
+    g->scent.reset();
+}
+
+static void check_scent_matches( const std::array<std::array<int, MAPSIZE_Y>, MAPSIZE_X> &expected )
+{
+    int mismatches = 0;
+    for( int x = 0; x < MAPSIZE_X; x++ ) {
+        for( int y = 0; y < MAPSIZE_Y; y++ ) {
+            if( expected[x][y] != g->scent.get( { x, y, 0 } ) ) {
+                INFO( x );
+                INFO( y );
+                CHECK( expected[x][y] == g->scent.get( { x, y, 0 } ) );
+                mismatches++;
+            }
+        }
+    }
+    CHECK( mismatches == 0 );
+}
+
+TEST_CASE( "scent_matches_scalar_update", "[scent]" )
+{
+    const tripoint origin( 60, 60, 0 );
+    set_up_scent_scenario( origin );
+    map &here = get_map();
+
+    std::array<std::array<int, MAPSIZE_Y>, MAPSIZE_X> expected{};
+    const auto add_scent = [&]( const tripoint & p, int value ) {
+        g->scent.set( p, value, scenttype_id( "sc_human" ) );
+        expected[p.x][p.y] = value;
+    };
+    const auto update = [&]( const tripoint & center ) {
+        g->scent.update( center, here );
+        scalar_scent_map_update( center, here, expected );
+    };
+
+    add_scent( origin, 1000 );
+    add_scent( origin + tripoint( 3, 3, 0 ), 500 );
+    for( int i = 0; i < 10; i++ ) {
+        update( origin );
+    }
+    check_scent_matches( expected );
+
+    SECTION( "after the center moves" ) {
+        for( int i = 0; i < 10; i++ ) {
+            const tripoint center = origin + tripoint( i, -i / 2, 0 );
+            add_scent( center, 800 );
+            update( center );
+        }
+        check_scent_matches( expected );
+    }
+
+    SECTION( "after terrain and furniture change" ) {
+        // Terrain with the same transparency, so only the scent flags tell the change apart
+        here.ter_set( origin + tripoint_north, t_floor );
+        here.furn_set( origin + tripoint( 0, 4, 0 ), f_null );
+        here.ter_set( origin + tripoint_east, t_brick_wall );
+        for( int i = 0; i < 10; i++ ) {
+            update( origin );
+        }
+        check_scent_matches( expected );
+    }
+}
+
+TEST_CASE( "scent_update_benchmark", "[.][scent][benchmark]" )
+{
+    const tripoint origin( 60, 60, 0 );
+    set_up_scent_scenario( origin );
+    map &here = get_map();
+    g->scent.set( origin, 1000, scenttype_id( "sc_human" ) );
+
+    std::array<std::array<int, MAPSIZE_Y>, MAPSIZE_X> scalar_scent{};
+    scalar_scent[origin.x][origin.y] = 1000;
+
+    BENCHMARK( "scalar update" ) {
+        scalar_scent_map_update( origin, here, scalar_scent );
+        return scalar_scent[origin.x][origin.y];
+    };
+    BENCHMARK( "scent_map::update" ) {
+        g->scent.update( origin, here );
+        return g->scent.get( origin );
+    };
+}
+
 TEST_CASE( "scent_matches_old", "[.]" )
 {
     clear_all_state();
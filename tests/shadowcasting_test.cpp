@@ -664,6 +664,77 @@ TEST_CASE( "shadowcasting_float_quad_performance", "[.]" )
     shadowcasting_float_quad( 1000000, 100 );
 }
 
+TEST_CASE( "sight_calc_from_table_matches_sight_calc", "[shadowcasting]" )
+{
+    // The transparencies casts come across: constants, and cumulative averages of them
+    std::vector<float> transparencies = { LIGHT_TRANSPARENCY_OPEN_AIR, LIGHT_TRANSPARENCY_OPEN_AIR * 1.1f,
+                                          LIGHT_TRANSPARENCY_SOLID
+                                        };
+    float cumulative = LIGHT_TRANSPARENCY_OPEN_AIR;
+    for( int distance = 1; distance < 60; distance++ ) {
+        const float current = distance % 3 == 0 ? LIGHT_TRANSPARENCY_OPEN_AIR * 5 :
+                              LIGHT_TRANSPARENCY_OPEN_AIR;
+        cumulative = accumulate_transparency( cumulative, current, distance );
+        transparencies.push_back( cumulative );
+    }
+
+    int mismatches = 0;
+    // Twice, the second time from the filled tables
+    for( int pass = 0; pass < 2; pass++ ) {
+        for( const float transparency : transparencies ) {
+            for( int distance = 0; distance < 100; distance++ ) {
+                if( sight_calc_from_table( VISIBILITY_FULL, transparency, distance ) !=
+                    sight_calc( VISIBILITY_FULL, transparency, distance ) ) {
+                    mismatches++;
+                }
+            }
+        }
+    }
+    CHECK( mismatches == 0 );
+}
+
+TEST_CASE( "shadowcasting_exp_table_benchmark", "[.][shadowcasting][benchmark]" )
+{
+    clear_all_state();
+    float transparency_cache[MAPSIZE * SEEX][MAPSIZE * SEEY] = {{0}};
+    diagonal_blocks blocked_cache[MAPSIZE * SEEX][MAPSIZE * SEEY] = {{{false, false}}};
+    bool floor_cache[MAPSIZE * SEEX][MAPSIZE * SEEY] = {{false}};
+    randomly_fill_transparency( transparency_cache );
+    // Not the open air of the fast paths, so every tile goes through sight_calc
+    for( auto &inner : transparency_cache ) {
+        for( float &square : inner ) {
+            if( square != LIGHT_TRANSPARENCY_SOLID ) {
+                square = LIGHT_TRANSPARENCY_OPEN_AIR * 2;
+            }
+        }
+    }
+    const point origin( 65, 65 );
+
+    four_quadrants lit_squares[MAPSIZE * SEEX][MAPSIZE * SEEY];
+    BENCHMARK( "castLightAll" ) {
+        castLightAll<float, four_quadrants, sight_calc, sight_check, update_light_quadrants,
+                     accumulate_transparency>( lit_squares, transparency_cache, blocked_cache, origin );
+        return lit_squares[origin.x][origin.y].max();
+    };
+
+    float seen_squares[MAPSIZE * SEEX][MAPSIZE * SEEY] = {{0}};
+    std::array<const float ( * )[MAPSIZE *SEEX][MAPSIZE *SEEY], OVERMAP_LAYERS> transparency_caches;
+    std::array<float ( * )[MAPSIZE *SEEX][MAPSIZE *SEEY], OVERMAP_LAYERS> seen_caches;
+    std::array<const bool ( * )[MAPSIZE *SEEX][MAPSIZE *SEEY], OVERMAP_LAYERS> floor_caches;
+    std::array<const diagonal_blocks( * )[MAPSIZE_X][MAPSIZE_Y], OVERMAP_LAYERS> blocked_caches;
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+        transparency_caches[z + OVERMAP_DEPTH] = &transparency_cache;
+        seen_caches[z + OVERMAP_DEPTH] = &seen_squares;
+        floor_caches[z + OVERMAP_DEPTH] = &floor_cache;
+        blocked_caches[z + OVERMAP_DEPTH] = &blocked_cache;
+    }
+    BENCHMARK( "cast_zlight" ) {
+        cast_zlight<float, sight_calc, sight_check, accumulate_transparency>(
+            seen_caches, transparency_caches, floor_caches, blocked_caches, tripoint( origin, 0 ), 0, 1.0 );
+        return seen_squares[origin.x][origin.y];
+    };
+}
+
 // I'm not sure this will ever work.
 TEST_CASE( "bresenham_vs_shadowcasting", "[.]" )
 {
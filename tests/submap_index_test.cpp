@@ -0,0 +1,118 @@
+#include "catch/catch.hpp"
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "point.h"
+#include "rng.h"
+#include "submap_index.h"
+
+TEST_CASE( "submap_index_basic", "[submap_index]" )
+{
+    submap_index<std::unique_ptr<int>> index;
+    std::map<tripoint, int> expected;
+
+    // Spans chunk boundaries and negative coordinates.
+    int value = 0;
+    for( int z = -1; z <= 1; z++ ) {
+        for( int y = -9; y <= 9; y += 3 ) {
+            for( int x = -9; x <= 9; x += 2 ) {
+                std::unique_ptr<int> v = std::make_unique<int>( value );
+                REQUIRE( index.insert( tripoint( x, y, z ), v ) );
+                CHECK( v == nullptr );
+                expected[tripoint( x, y, z )] = value++;
+            }
+        }
+    }
+    CHECK( index.size() == expected.size() );
+
+    std::unique_ptr<int> dup = std::make_unique<int>( -1 );
+    CHECK_FALSE( index.insert( tripoint( -9, -9, -1 ), dup ) );
+    CHECK( dup != nullptr );
+
+    for( const auto &kv : expected ) {
+        const int *v = index.find( kv.first );
+        REQUIRE( v != nullptr );
+        CHECK( *v == kv.second );
+    }
+    CHECK_FALSE( index.contains( tripoint( -8, -9, -1 ) ) );
+    CHECK_FALSE( index.contains( tripoint( 0, 0, 2 ) ) );
+
+    std::map<tripoint, int> visited;
+    index.for_each( [&]( const tripoint & p, std::unique_ptr<int> &v ) {
+        visited[p] = *v;
+    } );
+    CHECK( visited == expected );
+
+    std::unique_ptr<int> removed = index.extract( tripoint( 1, 0, 0 ) );
+    REQUIRE( removed != nullptr );
+    CHECK( *removed == expected[tripoint( 1, 0, 0 )] );
+    CHECK_FALSE( index.contains( tripoint( 1, 0, 0 ) ) );
+    CHECK( index.extract( tripoint( 1, 0, 0 ) ) == nullptr );
+    CHECK( index.size() == expected.size() - 1 );
+
+    index.clear();
+    CHECK( index.empty() );
+    CHECK_FALSE( index.contains( tripoint( -9, -9, -1 ) ) );
+}
+
+TEST_CASE( "submap_index_lookup_benchmark", "[.][submap_index][benchmark]" )
+{
+    // About the size of the mapbuffer of a long-lived world.
+    constexpr int num_submaps = 50000;
+    constexpr int side = 50;
+
+    std::map<tripoint, std::unique_ptr<int>> tree;
+    submap_index<std::unique_ptr<int>> index;
+    std::vector<tripoint> points;
+    for( int i = 0; i < num_submaps; i++ ) {
+        // Clusters of explored areas scattered around the world.
+        const int cluster = i / ( side * side );
+        const tripoint p( ( cluster / 3 ) * 97 + i % side, ( i / side ) % side, cluster % 3 - 1 );
+        points.push_back( p );
+        tree[p] = std::make_unique<int>( i );
+        std::unique_ptr<int> v = std::make_unique<int>( i );
+        index.insert( p, v );
+    }
+    std::vector<tripoint> random_points;
+    for( int i = 0; i < 1000; i++ ) {
+        random_points.push_back( random_entry( points ) );
+    }
+    // The lookups of one map shift: a column of the 11x11 grid on every z-level.
+    std::vector<tripoint> shift;
+    for( int z = -1; z <= 1; z++ ) {
+        for( int y = 0; y < 11; y++ ) {
+            shift.emplace_back( 10, 20 + y, z );
+        }
+    }
+
+    BENCHMARK( "std::map, random lookups" ) {
+        int sum = 0;
+        for( const tripoint &p : random_points ) {
+            sum += *tree.find( p )->second;
+        }
+        return sum;
+    };
+    BENCHMARK( "submap_index, random lookups" ) {
+        int sum = 0;
+        for( const tripoint &p : random_points ) {
+            sum += *index.find( p );
+        }
+        return sum;
+    };
+    BENCHMARK( "std::map, map shift" ) {
+        int sum = 0;
+        for( const tripoint &p : shift ) {
+            sum += *tree.find( p )->second;
+        }
+        return sum;
+    };
+    BENCHMARK( "submap_index, map shift" ) {
+        int sum = 0;
+        for( const tripoint &p : shift ) {
+            sum += *index.find( p );
+        }
+        return sum;
+    };
+}
@@ -0,0 +1,93 @@
+#include "catch/catch.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <map>
+#include <vector>
+
+#include "map.h"
+#include "point.h"
+#include "state_helpers.h"
+#include "type_id.h"
+#include "vehicle.h"
+#include "vehicle_mount_index.h"
+#include "vpart_position.h"
+#include "vpart_range.h"
+
+TEST_CASE( "vehicle_mount_index_grows_to_fit", "[vehicle]" )
+{
+    vehicle_mount_index index;
+    CHECK_FALSE( index.contains( point_zero ) );
+
+    std::map<point, std::vector<int>> expected;
+    int part = 0;
+    // Out of order and on both sides of the origin, so the grid has to grow every way
+    for( const point &p : {
+             point( 2, 1 ), point( -3, 0 ), point( 2, 1 ), point( 0, -4 ), point( 5, 5 ), point( -3, 0 )
+         } ) {
+        index[p].push_back( part );
+        expected[p].push_back( part );
+        part++;
+    }
+    for( int y = -6; y <= 6; y++ ) {
+        for( int x = -6; x <= 6; x++ ) {
+            const point p( x, y );
+            CAPTURE( p );
+            const auto it = expected.find( p );
+            const std::vector<int> *found = index.find( p );
+            if( it == expected.end() ) {
+                CHECK( found == nullptr );
+            } else {
+                REQUIRE( found != nullptr );
+                CHECK( *found == it->second );
+            }
+        }
+    }
+
+    index.reset( point( -1, -1 ), point( 1, 1 ) );
+    CHECK_FALSE( index.contains( point( 2, 1 ) ) );
+    CHECK_FALSE( index.contains( point_zero ) );
+}
+
+TEST_CASE( "vehicle_parts_at_relative_match_parts", "[vehicle]" )
+{
+    clear_all_state();
+    map &here = get_map();
+    vehicle *veh = here.add_vehicle( vproto_id( "bus" ), tripoint( 30, 30, 0 ), 0_degrees, 0, 0 );
+    REQUIRE( veh != nullptr );
+
+    const auto check_index = [veh]() {
+        for( int y = -15; y <= 15; y++ ) {
+            for( int x = -15; x <= 15; x++ ) {
+                const point p( x, y );
+                CAPTURE( p );
+                std::vector<int> cached = veh->parts_at_relative( p, true );
+                std::vector<int> uncached = veh->parts_at_relative( p, false );
+                std::sort( cached.begin(), cached.end() );
+                CHECK( cached == uncached );
+            }
+        }
+    };
+    check_index();
+
+    // Removing parts shrinks the vehicle and shifts it around
+    int min_x = INT_MAX;
+    int max_x = INT_MIN;
+    for( const vpart_reference &vp : veh->get_all_parts() ) {
+        min_x = std::min( min_x, vp.mount().x );
+        max_x = std::max( max_x, vp.mount().x );
+    }
+    std::vector<int> to_remove;
+    for( const vpart_reference &vp : veh->get_all_parts() ) {
+        if( vp.mount().x > ( min_x + max_x ) / 2 ) {
+            to_remove.push_back( static_cast<int>( vp.part_index() ) );
+        }
+    }
+    REQUIRE_FALSE( to_remove.empty() );
+    for( int p : to_remove ) {
+        veh->remove_part( p );
+    }
+    check_index();
+    veh->part_removal_cleanup();
+    check_index();
+}
@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <optional>
+#include <set>
 #include <vector>
 
 #include "avatar.h"
@@ -11,12 +12,14 @@
 #include "item.h"
 #include "map.h"
 #include "map_helpers.h"
+#include "monster.h"
 #include "point.h"
 #include "state_helpers.h"
 #include "type_id.h"
 #include "vehicle.h"
 #include "vehicle_part.h"
 #include "vpart_position.h"
+#include "vpart_range.h"
 #include "veh_type.h"
 
 TEST_CASE( "detaching_vehicle_unboards_passengers" )
@@ -201,3 +204,64 @@ TEST_CASE( "vehicle_rotation_reverse" )
         }
     }
 }
+
+TEST_CASE( "vehicle_collision_broadphase_finds_creatures", "[vehicle]" )
+{
+    clear_all_state();
+    map &here = get_map();
+    avatar &you = get_avatar();
+    vehicle *veh = here.add_vehicle( vproto_id( "car" ), tripoint( 60, 60, 0 ), 0_degrees, 0, 0 );
+    REQUIRE( veh != nullptr );
+    veh->precalc_mounts( 1, veh->face.dir(), veh->pivot_point() );
+
+    // The crew rides along, so it can't be in the way
+    std::optional<tripoint> seat;
+    for( const vpart_reference &vp : veh->get_avail_parts( "BOARDABLE" ) ) {
+        seat = vp.pos();
+        break;
+    }
+    REQUIRE( seat );
+    you.setpos( *seat );
+    here.board_vehicle( *seat, &you );
+    REQUIRE( you.in_vehicle );
+    const tripoint dp( 1, 0, 0 );
+
+    // Where the parts would move to, outside of where the vehicle is now
+    const std::set<tripoint> &occupied = veh->get_points( true );
+    std::vector<tripoint> ahead;
+    for( const vpart_reference &vp : veh->get_all_parts() ) {
+        if( vp.info().location != "structure" ) {
+            continue;
+        }
+        const tripoint dsp = veh->global_pos3() + dp + vp.part().precalc[1];
+        if( !occupied.contains( dsp ) ) {
+            ahead.push_back( dsp );
+        }
+    }
+    REQUIRE( ahead.size() >= 2 );
+
+    vehicle::reset_collision_stats();
+    std::vector<veh_collision> colls;
+    CHECK_FALSE( veh->collision( colls, dp, true ) );
+    CHECK( vehicle::get_collision_stats().parts_checked == 0 );
+    CHECK( vehicle::get_collision_stats().parts_culled > 0 );
+    REQUIRE( colls.empty() );
+
+    SECTION( "a monster in the way" ) {
+        monster &zombie = spawn_test_monster( "mon_zombie", ahead.front() );
+        CHECK( veh->collision( colls, dp, true ) );
+        REQUIRE( colls.size() == 1 );
+        CHECK( colls.front().type == veh_coll_body );
+        CHECK( colls.front().target == &zombie );
+        CHECK( vehicle::get_collision_stats().parts_checked > 0 );
+    }
+
+    SECTION( "the player in the way" ) {
+        here.unboard_vehicle( *seat );
+        you.setpos( ahead.back() );
+        CHECK( veh->collision( colls, dp, true ) );
+        REQUIRE( colls.size() == 1 );
+        CHECK( colls.front().type == veh_coll_body );
+        CHECK( colls.front().target == &you );
+    }
+}
@@ -1,6 +1,7 @@
 #include "catch/catch.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
 #include <iomanip>
 #include <list>
@@ -717,3 +718,61 @@ TEST_CASE( "vision_see_into_vehicle", "[shadowcasting][vision]" )
 
     t.test();
 }
+
+static std::vector<std::array<float, 4>> lightmap_snapshot( const map &here, int zlev )
+{
+    const level_cache &cache = here.access_cache( zlev );
+    std::vector<std::array<float, 4>> result;
+    for( int x = 0; x < MAPSIZE_X; x++ ) {
+        for( int y = 0; y < MAPSIZE_Y; y++ ) {
+            result.push_back( cache.lm[x][y].values );
+        }
+    }
+    return result;
+}
+
+TEST_CASE( "incremental_lightmap_matches_full_rebuild", "[shadowcasting][vision]" )
+{
+    clear_all_state();
+    const ter_id t_utility_light( "t_utility_light" );
+    const ter_id t_brick_wall( "t_brick_wall" );
+    const ter_id t_dirt( "t_dirt" );
+    const tripoint origin( 60, 60, 0 );
+    g->place_player( origin );
+    calendar::turn = midnight;
+    get_weather().weather_id = weather_type_id( "clear" );
+    g->reset_light_level();
+
+    map &here = get_map();
+    here.ter_set( origin + point( -10, -10 ), t_utility_light );
+    here.ter_set( origin + point( 12, -4 ), t_utility_light );
+    here.ter_set( origin + point( 3, 9 ), t_utility_light );
+    here.ter_set( origin + point( 4, 9 ), t_utility_light );
+    here.invalidate_map_cache( origin.z );
+    here.build_map_cache( origin.z );
+
+    WHEN( "nothing changes" ) {
+        const std::vector<std::array<float, 4>> before = lightmap_snapshot( here, origin.z );
+        here.build_map_cache( origin.z );
+        THEN( "the lightmap stays the same" ) {
+            CHECK( lightmap_snapshot( here, origin.z ) == before );
+        }
+    }
+
+    WHEN( "lights and walls change" ) {
+        here.ter_set( origin + point( -10, -10 ), t_dirt );
+        here.ter_set( origin + point( 12, -3 ), t_brick_wall );
+        here.ter_set( origin + point( 4, 9 ), t_dirt );
+        here.ter_set( origin + point( -6, 14 ), t_utility_light );
+        here.build_map_cache( origin.z );
+        const std::vector<std::array<float, 4>> incremental = lightmap_snapshot( here, origin.z );
+
+        here.set_lightmap_dirty( origin.z );
+        here.build_map_cache( origin.z );
+        const std::vector<std::array<float, 4>> full = lightmap_snapshot( here, origin.z );
+
+        THEN( "the incremental lightmap matches a full rebuild" ) {
+            CHECK( incremental == full );
+        }
+    }
+}
@@ -5,6 +5,7 @@
 #include <vector>
 
 #include "calendar.h"
+#include "game.h"
 #include "point.h"
 #include "weather.h"
 #include "weather_gen.h"
@@ -111,6 +112,31 @@ TEST_CASE( "eternal seasons", "[weather]" )
     }
 }
 
+TEST_CASE( "past temperatures match the weather generator", "[weather]" )
+{
+    weather_manager &weather = get_weather();
+    const weather_generator &generator = weather.get_cur_weather_gen();
+    weather.clear_temp_cache();
+
+    const std::vector<tripoint_abs_ms> locations = {
+        tripoint_abs_ms( 0, 0, 0 ), tripoint_abs_ms( 1, 0, 0 ), tripoint_abs_ms( 5000, -300, 2 )
+    };
+    for( int pass = 0; pass < 2; pass++ ) {
+        for( const tripoint_abs_ms &location : locations ) {
+            for( time_point t = calendar::turn_zero; t < calendar::turn_zero + 3_days; t += 1_hours ) {
+                CAPTURE( pass, location, to_turn<int>( t ) );
+                CHECK( weather.get_past_temperature( location, t ) ==
+                       generator.get_weather_temperature( location, t, calendar::config, g->get_seed() ) );
+            }
+        }
+    }
+    // Every hour of every location was generated once, the second pass only hit the cache
+    CHECK( weather.past_temperature_cache.size() == locations.size() * 72 );
+
+    weather.clear_temp_cache();
+    CHECK( weather.past_temperature_cache.empty() );
+}
+
 TEST_CASE( "weather realism", "[.]" )
 // Check our simulated weather against numbers from real data
 // from a few years in a few locations in New England. The numbers